@@ -19,25 +19,28 @@
 #include <algorithm>
 #include <array>
 #include <vector>
-#include <deque>
 #include <iostream>
 #include <filesystem>
 #include <cstdlib>
 #include <optional>
 
+#include "core/telemetry/pipeline_timers.h"
 #include "core/telemetry/telemetry_bus.h"
+#include "core/telemetry/telemetry_recorder.h"
+#include "core/telemetry/telemetry_snapshot_pool.h"
 #include "core/telemetry/telemetry_snapshot.h"
 
 #include "core/audio/sndfile_replay_source.h"
 #include "core/audio/i_audio_source.h"
 
-#include "core/dsp/pcen_extractor.h"
+#include "core/dsp/pcen_presets.h"
 #include "core/dsp/pcen_ring_buffer.h"
 
 #include "core/detect/mock_detector.h"
 #include "core/segment/segment_builder.h"
 
 #if UAV_HAVE_TFLITE
+#include "core/detect/async_window_detector.h"
 #include "core/tflite/tcn_detector.h"
 #endif
 
@@ -335,10 +338,17 @@ int main(int argc, char* argv[]) {
     const auto arg_audio = GetArgValue(argc, argv, "--audio_file");
     const auto arg_model = GetArgValue(argc, argv, "--tflite_model");
     const auto arg_labels = GetArgValue(argc, argv, "--tflite_labels");
+    const auto arg_tfl_threads = GetArgValue(argc, argv, "--tflite_threads");        // default -1: TFLite default, 0: auto
+    const auto arg_tfl_xnnpack = GetArgValue(argc, argv, "--tflite_xnnpack");        // 1: explicit XNNPACK delegate
+    const auto arg_tfl_fp16 = GetArgValue(argc, argv, "--tflite_xnnpack_fp16");      // 1: force fp16 (XNNPACK)
+    const auto arg_tfl_dynamic = GetArgValue(argc, argv, "--tflite_xnnpack_dynamic"); // 1: dynamic range FC (XNNPACK)
+    const auto arg_record = GetArgValue(argc, argv, "--telemetry_record");
+    const auto arg_latency_dump = GetArgValue(argc, argv, "--latency_dump");  // seconds between dumps, 0: at exit only
 
     const char* env_audio = std::getenv("UAV_AUDIO_FILE");
     const char* env_model = std::getenv("UAV_TFLITE_MODEL");
     const char* env_labels = std::getenv("UAV_TFLITE_LABELS");
+    const char* env_record = std::getenv("UAV_TELEMETRY_RECORD");
 
     if (arg_audio.has_value()) {
         audio_path = std::filesystem::path(arg_audio.value()).string();
@@ -350,28 +360,35 @@ int main(int argc, char* argv[]) {
     std::cout << "[AUDIO] configured source file: " << audio_path << "\n";
 
     auto bus = std::make_shared<core::telemetry::TelemetryBus>();
+    // Snapshots come from a pool: no heap allocation per publish in steady state
+    core::telemetry::TelemetrySnapshotPool snapshot_pool(32);
+
+    // --- Flight recorder (optional): every snapshot -> <prefix>_NNNNNN.trec ---
+    // Async subscriber: page faults and file rotation never hit the audio thread.
+    core::telemetry::TelemetryRecorder recorder;
+    std::uint64_t recorder_sub = 0;
+    const std::string record_prefix = arg_record.value_or(env_record ? env_record : "");
+    if (!record_prefix.empty()) {
+        core::telemetry::TelemetryRecorder::Config rcfg;
+        rcfg.path_prefix = record_prefix;
+        if (recorder.Open(rcfg)) {
+            core::telemetry::TelemetryBus::SubscribeOptions ropt;
+            ropt.async = true;
+            ropt.queue_capacity = 256;
+            recorder_sub = bus->Subscribe(
+                [&recorder](core::telemetry::TelemetryBus::SnapshotPtr s) { recorder.Record(*s); }, ropt);
+            std::cout << "[RECORDER] writing telemetry to " << recorder.current_path() << "\n";
+        }
+    }
 
     auto pcen_rb = std::make_shared<core::dsp::PcenRingBuffer>(
         /*n_mels=*/128,
-        /*capacity_frames=*/1500
+        /*capacity_frames=*/1500,
+        /*mirrored=*/true  // contiguous TCN windows; falls back to a heap buffer
     );
 
-    core::dsp::PcenConfig pcfg;
-    pcfg.sample_rate = 22050;
-    pcfg.n_fft = 1024;
-    pcfg.win_length = 1024;
-    pcfg.hop_length = 256;
-    pcfg.n_mels = 128;
-    pcfg.alpha = 0.6f;
-    pcfg.delta = 2.0f;
-    pcfg.r = 0.1f;
-    pcfg.eps = 1e-6f;
-    {
-        const float time_constant = 0.4f;
-        const float hop_sec = static_cast<float>(pcfg.hop_length) / static_cast<float>(pcfg.sample_rate);
-        pcfg.s = 1.0f - std::exp(-hop_sec / time_constant);
-    }
-    core::dsp::PcenExtractor pcen(pcfg);
+    const core::dsp::PcenConfig pcfg = core::dsp::ProductionPcenConfig();
+    core::dsp::ProductionPcenExtractor pcen(core::dsp::ParamsOf(pcfg));
 
 #if UAV_HAVE_TFLITE
     // --- TCN detector (TensorFlow Lite) ---
@@ -380,6 +397,10 @@ int main(int argc, char* argv[]) {
     tcfg.class_names_path = arg_labels.value_or(env_labels ? env_labels : "class_names.txt");
     tcfg.n_mels = 128;
     tcfg.n_frames = 169;
+    if (arg_tfl_threads) tcfg.runner.num_threads = std::atoi(arg_tfl_threads->c_str());
+    tcfg.runner.xnnpack = arg_tfl_xnnpack && std::atoi(arg_tfl_xnnpack->c_str()) != 0;
+    tcfg.runner.xnnpack_fp16 = arg_tfl_fp16 && std::atoi(arg_tfl_fp16->c_str()) != 0;
+    tcfg.runner.xnnpack_dynamic_range = arg_tfl_dynamic && std::atoi(arg_tfl_dynamic->c_str()) != 0;
     core::ml::TcnDetector tcn(tcfg);
     std::cout << "[DETECTOR] configured TFLite model: " << tcfg.model_path << "\n";
     std::cout << "[DETECTOR] configured labels file: " << tcfg.class_names_path << "\n";
@@ -389,6 +410,11 @@ int main(int argc, char* argv[]) {
         std::cout << "[DETECTOR] Hint: pass --tflite_model=/path/model.tflite and --tflite_labels=/path/class_names.txt\n"
             << "           or use env UAV_TFLITE_MODEL / UAV_TFLITE_LABELS\n";
     }
+
+    // TCN runs on its own worker: the audio thread posts the newest window and picks up
+    // the newest result, it never waits for Invoke(). Stops before tcn is destroyed.
+    core::detect::AsyncWindowDetector tcn_async(pcen_rb, &tcn);
+    const bool tcn_async_ok = tcn.IsValid() && tcn_async.Start();
 #else
     std::cout << "[DETECTOR] TCN compile-time disabled, using MOCK detector\n";
 #endif
@@ -435,6 +461,12 @@ int main(int argc, char* argv[]) {
 
     MainWidget window(telemetry, pcenProvider);
 
+    // --- Stage timers (histograms per audio loop stage, see PipelineStage) ---
+    using core::telemetry::PipelineStage;
+    using StageTimer = core::telemetry::PipelineTimers::Scope;
+    core::telemetry::PipelineTimers timers;
+    const int latency_dump_s = arg_latency_dump ? std::max(0, std::atoi(arg_latency_dump->c_str())) : -1;
+
     // ---- Audio replay + PCEN + detector thread ----
     std::atomic<bool> running{ true };
     std::thread audio_thread([&] {
@@ -452,27 +484,41 @@ int main(int argc, char* argv[]) {
             return;
         }
 
-        std::vector<float> pcen_frames;
-        pcen_frames.reserve(128 * 32);
+        // Reused across chunks (no per-chunk allocation once sized)
+        std::vector<float> mono;
 
-        std::deque<float> p_hist;
-        const int kHistN = 64;
+#if UAV_HAVE_TFLITE
+        // Newest TCN result; used while its window is at most kTcnMaxAgeNs older than the chunk
+        constexpr std::int64_t kTcnMaxAgeNs = 500'000'000;
+        core::detect::AsyncWindowDetector::Result tcn_latest;
+        bool tcn_have_result = false;
+#endif
 
-        const std::int64_t hop_ns = static_cast<std::int64_t>(pcfg.hop_length) * 1'000'000'000LL / pcfg.sample_rate;
         const int dt_ms = acfg.chunk_ms;
 
+        // Latency summary copied into every snapshot, refreshed every kLatencyRefreshChunks
+        constexpr int kLatencyRefreshChunks = 25;  // 0.5 s
+        core::telemetry::PipelineLatency latency;
+        int chunks_since_refresh = 0;
+        std::int64_t last_dump_ns = now_ns();
+
         while (running.load()) {
+            StageTimer t_read(&timers, PipelineStage::SOURCE_READ);
             auto chunk = src.Read();
+            t_read.Stop();
             if (!chunk) {
                 std::this_thread::sleep_for(std::chrono::milliseconds(10));
                 continue;
             }
 
+            StageTimer t_chunk(&timers, PipelineStage::CHUNK_TOTAL);
+            const std::int64_t chunk_start_ns = now_ns();
             const int frames = chunk->frames;
             const int ch = chunk->channels;
 
             // Interleaved float -> mono
-            std::vector<float> mono(static_cast<std::size_t>(frames), 0.0f);
+            StageTimer t_downmix(&timers, PipelineStage::DOWNMIX);
+            mono.resize(static_cast<std::size_t>(frames));
             const float* inter = chunk->interleaved.data();
 
             if (ch == 1) {
@@ -486,44 +532,45 @@ int main(int argc, char* argv[]) {
                 }
             }
 
+            t_downmix.Stop();
+
             // --- PCEN -> ring buffer ---
-            pcen_frames.clear();
-            const int produced = pcen.Process(mono.data(), frames, &pcen_frames);
+            StageTimer t_pcen(&timers, PipelineStage::PCEN);
+            // Frames are written straight into ring buffer slots
+            // (stamped with the time of their first sample; chunk->t0_ns is the chunk start)
+            const int produced = pcen.Process(mono.data(), frames, pcen_rb.get(), chunk->t0_ns);
             if (produced > 0) {
-                const int mels = pcen.n_mels();
-                //    PCEN-:  t0 
-                // (AudioChunk::t0_ns   )
-                const std::int64_t base_ns = chunk->t0_ns;
-
-                for (int i = 0; i < produced; ++i) {
-                    const float* frame_ptr = &pcen_frames[static_cast<std::size_t>(i * mels)];
-                    pcen_rb->PushFrame(frame_ptr);
-
-                    const std::int64_t frame_t_ns = base_ns + hop_ns * i;
-                    segment_builder.OnFramePushed(frame_t_ns);
-                }
+                segment_builder.OnFramesPushed();
             }
+            t_pcen.Stop();
 
             // Run inference (TCN when available, mock fallback otherwise)
+            StageTimer t_infer(&timers, PipelineStage::INFERENCE);
             float p = detector.Process(mono.data(), frames);
+            std::int64_t p_t_ns = chunk->t0_ns;  // audio time p was computed from
             bool tcn_used_for_latest = false;
 #if UAV_HAVE_TFLITE
-            if (tcn.IsValid()) {
-                std::vector<float> tcn_scores;
-                int available_frames = 0;
-                const auto pcen_window = pcen_rb->SnapshotLast(tcfg.n_frames, &available_frames);
-                const int need = tcfg.n_mels * tcfg.n_frames;
-                if (available_frames == tcfg.n_frames && static_cast<int>(pcen_window.size()) == need) {
-                    const int best = tcn.Run(pcen_window.data(), need, &tcn_scores);
-                    if (best >= 0 && !tcn_scores.empty()) {
-                        p = std::clamp(tcn_scores[static_cast<std::size_t>(best)], 0.0f, 1.0f);
-                        tcn_used_for_latest = true;
-                    }
+            if (tcn_async_ok) {
+                // Hand the newest window to the worker (replaces one it has not started on)
+                tcn_async.Post(pcen_rb->frames_written());
+
+                core::detect::AsyncWindowDetector::Result r;
+                if (tcn_async.TakeLatest(&r)) {
+                    tcn_latest = r;
+                    tcn_have_result = true;
+                    timers.Record(PipelineStage::MODEL, r.infer_ns);
+                }
+                if (tcn_have_result && chunk->t0_ns - tcn_latest.window_t_ns <= kTcnMaxAgeNs) {
+                    p = tcn_latest.p_detect;
+                    p_t_ns = tcn_latest.window_t_ns;
+                    tcn_used_for_latest = true;
                 }
             }
 #endif
+            t_infer.Stop();
 
             // --- FSM update ---
+            StageTimer t_fsm(&timers, PipelineStage::FSM);
             bool event_started = false;
             bool event_ended = false;
 
@@ -590,9 +637,12 @@ int main(int argc, char* argv[]) {
                 }
             }
 
+            t_fsm.Stop();
+
             const std::int64_t t_ns = now_ns();
 
             // Segment builder hooks
+            StageTimer t_segment(&timers, PipelineStage::SEGMENT);
             if (event_started) segment_builder.OnEventStart(t_ns);
             if (event_ended) segment_builder.OnEventEnd(t_ns);
 
@@ -604,12 +654,14 @@ int main(int argc, char* argv[]) {
                     << std::endl;
             }
 
-            // history for plot
-            p_hist.push_back(p);
-            while (static_cast<int>(p_hist.size()) > kHistN) p_hist.pop_front();
+            t_segment.Stop();
+
+            // history for plot (kept by the bus, O(1) per chunk)
+            StageTimer t_publish(&timers, PipelineStage::PUBLISH);
+            bus->AppendTimeline(core::telemetry::TimelinePoint{ t_ns, p });
 
             // publish telemetry snapshot
-            auto s = std::make_shared<core::telemetry::TelemetrySnapshot>();
+            auto s = snapshot_pool.Acquire();
             s->t_ns = t_ns;
             s->p_detect_latest = p;
             s->fsm_state = fsm;
@@ -619,21 +671,28 @@ int main(int argc, char* argv[]) {
             s->tcn_available = false;
 #endif
             s->tcn_used_for_latest = tcn_used_for_latest;
+            s->p_detect_t_ns = p_t_ns;
 
             //       TelemetrySnapshot
             s->event_started = event_started;
             s->event_ended = event_ended;
-
-            s->timeline_n = static_cast<int>(p_hist.size());
-            const std::int64_t step_ns = static_cast<std::int64_t>(acfg.chunk_ms) * 1'000'000LL;
-            const std::int64_t base_plot = s->t_ns - step_ns * static_cast<std::int64_t>(s->timeline_n);
-
-            for (int i = 0; i < s->timeline_n; ++i) {
-                s->timeline[static_cast<std::size_t>(i)].t_ns = base_plot + step_ns * i;
-                s->timeline[static_cast<std::size_t>(i)].p_detect = p_hist[static_cast<std::size_t>(i)];
-            }
+            s->latency = latency;
 
             bus->Publish(std::move(s));
+            t_publish.Stop();
+            t_chunk.Stop();
+
+            // realtime factor: processing time (source wait excluded) per audio time
+            timers.RecordChunk(now_ns() - chunk_start_ns,
+                static_cast<std::int64_t>(frames) * 1'000'000'000LL / std::max(1, chunk->sample_rate));
+            if (++chunks_since_refresh >= kLatencyRefreshChunks) {
+                latency = timers.Summarize();
+                chunks_since_refresh = 0;
+            }
+            if (latency_dump_s > 0 && t_ns - last_dump_ns >= static_cast<std::int64_t>(latency_dump_s) * 1'000'000'000LL) {
+                timers.Dump(std::cout);
+                last_dump_ns = t_ns;
+            }
         }
     });
     window.show();
@@ -641,5 +700,10 @@ int main(int argc, char* argv[]) {
 
     running.store(false);
     audio_thread.join();
+    if (recorder_sub != 0) bus->Unsubscribe(recorder_sub);  // joins the delivery thread before recorder goes away
+    if (latency_dump_s >= 0) {
+        std::cout << "[LATENCY] audio loop stages:\n";
+        timers.Dump(std::cout);
+    }
     return rc;
 }
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+    struct Options {
+        int iters = 200;
+    };
+
+    // One named case. Returns false if a validation check failed.
+    struct Case {
+        const char* name;
+        const char* help;
+        bool (*run)(const Options& opt);
+    };
+
+    // Registered cases (one list per bench_*.cpp)
+    std::vector<Case> DspCases();
+    std::vector<Case> RingCases();
+    std::vector<Case> TelemetryCases();
+    std::vector<Case> DetectCases();
+    std::vector<Case> TfliteCases();  // only with UAV_BENCH_HAVE_TFLITE
+
+    inline double NowUs() {
+        using namespace std::chrono;
+        return duration<double, std::micro>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Runs fn() `iters` times, returns mean microseconds per call.
+    template <class Fn>
+    double TimeUs(int iters, Fn&& fn) {
+        fn();  // warm-up
+        const double t0 = NowUs();
+        for (int i = 0; i < iters; ++i) fn();
+        return (NowUs() - t0) / static_cast<double>(iters > 0 ? iters : 1);
+    }
+
+}  // namespace bench
@@ -0,0 +1,243 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+
+#include "core/detect/async_window_detector.h"
+#include "core/dsp/pcen_ring_buffer.h"
+
+namespace bench {
+
+    namespace {
+
+        // Stand-in for the TCN: takes `cost` per window and checks the window it was given
+        // (frame f of the ring holds the value f in every mel band, so a correct window is
+        // n_frames consecutive values).
+        class FakeWindowModel : public core::detect::IWindowModel {
+        public:
+            FakeWindowModel(int n_mels, int n_frames, std::chrono::microseconds cost)
+                : n_mels_(n_mels), n_frames_(n_frames), cost_(cost),
+                input_(static_cast<std::size_t>(n_mels) * static_cast<std::size_t>(n_frames)) {}
+
+            int n_mels() const override { return n_mels_; }
+            int n_frames() const override { return n_frames_; }
+            float* input_buffer() override { return input_.data(); }
+
+            bool Infer(float* p_detect) override {
+                const float first = input_[0];
+                bool ok = true;
+                for (int f = 0; f < n_frames_ && ok; ++f) {
+                    for (int m = 0; m < n_mels_; ++m) {
+                        if (input_[static_cast<std::size_t>(f * n_mels_ + m)] != first + static_cast<float>(f)) {
+                            ok = false;
+                            break;
+                        }
+                    }
+                }
+                if (!ok) bad_windows.fetch_add(1, std::memory_order_relaxed);
+                std::this_thread::sleep_for(cost_);  // the model's Invoke
+                *p_detect = ok ? 1.0f : 0.0f;
+                return true;
+            }
+
+            std::atomic<int> bad_windows{ 0 };
+
+        private:
+            int n_mels_;
+            int n_frames_;
+            std::chrono::microseconds cost_;
+            std::vector<float> input_;
+        };
+
+        // Audio loop compressed 10x (2 ms per chunk, 2 frames each) against a model that needs
+        // 7 ms per window: inline inference would fall 3.5x behind; with the worker the loop
+        // keeps its pace, stale windows are dropped and every result is a correct window.
+        bool RunAsyncDetector(const Options& opt) {
+            const int n_mels = 128;
+            const int n_frames = 169;
+            const int frames_per_chunk = 2;
+            const auto chunk_period = std::chrono::microseconds(2000);
+            const std::int64_t frame_ns = 10'000'000;
+            const int chunks = std::max(500, opt.iters);
+
+            auto ring = std::make_shared<core::dsp::PcenRingBuffer>(n_mels, 1500);
+            FakeWindowModel model(n_mels, n_frames, std::chrono::microseconds(7000));
+            core::detect::AsyncWindowDetector det(ring, &model);
+            if (!det.Start()) return false;
+
+            std::vector<float> frame(static_cast<std::size_t>(n_mels));
+            std::uint64_t seq = 0;
+            double post_max_us = 0.0;
+            double loop_max_us = 0.0;
+            std::uint64_t results = 0;
+            std::uint64_t last_end = 0;
+            bool ordered = true;
+            bool times_ok = true;
+
+            const auto start = std::chrono::steady_clock::now();
+            for (int c = 0; c < chunks; ++c) {
+                std::this_thread::sleep_until(start + chunk_period * c);
+                const double t0 = NowUs();
+                for (int k = 0; k < frames_per_chunk; ++k, ++seq) {
+                    std::fill(frame.begin(), frame.end(), static_cast<float>(seq));
+                    ring->PushFrame(frame.data(), static_cast<std::int64_t>(seq) * frame_ns);
+                }
+                const double p0 = NowUs();
+                det.Post(ring->frames_written());
+                core::detect::AsyncWindowDetector::Result r;
+                const bool got = det.TakeLatest(&r);
+                post_max_us = std::max(post_max_us, NowUs() - p0);
+                loop_max_us = std::max(loop_max_us, NowUs() - t0);
+
+                if (got) {
+                    ++results;
+                    ordered = ordered && r.window_end_seq > last_end && r.p_detect == 1.0f;
+                    times_ok = times_ok && r.window_t_ns == static_cast<std::int64_t>(r.window_end_seq - 1) * frame_ns;
+                    last_end = r.window_end_seq;
+                }
+            }
+            const double wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            det.Stop();
+
+            const auto st = det.stats();
+            std::printf("  %d chunks in %.0f ms (budget %.0f ms)  loop max %.1f us  Post+Take max %.1f us\n",
+                chunks, wall_ms, static_cast<double>(chunks) * 2.0, loop_max_us, post_max_us);
+            std::printf("  posted %llu  inferred %llu  dropped stale %llu  skipped %llu  taken by loop %llu  bad windows %d\n",
+                static_cast<unsigned long long>(st.posted), static_cast<unsigned long long>(st.inferred),
+                static_cast<unsigned long long>(st.dropped), static_cast<unsigned long long>(st.skipped),
+                static_cast<unsigned long long>(results), model.bad_windows.load());
+            std::printf("  inline inference would take %.0f ms for the same audio\n", static_cast<double>(chunks) * 7.0);
+
+            return ordered && times_ok && model.bad_windows.load() == 0 && st.inferred > 0 && st.dropped > 0 &&
+                st.inferred + st.dropped + st.skipped + st.failed == st.posted && results > 0 &&
+                wall_ms < static_cast<double>(chunks) * 2.0 * 1.5;
+        }
+
+        // Streaming stand-in: `step` frames per Infer(), state = the last n_frames frame values
+        // (zero after ResetState()), p_detect = their mean, i.e. what a window model gives for
+        // the same window (frame f holds the value f, sums stay exact in float).
+        class FakeStreamModel : public core::detect::IWindowModel {
+        public:
+            FakeStreamModel(int n_mels, int n_frames, int step, std::chrono::microseconds cost)
+                : n_mels_(n_mels), n_frames_(n_frames), step_(step), cost_(cost),
+                input_(static_cast<std::size_t>(n_mels) * static_cast<std::size_t>(step)),
+                state_(static_cast<std::size_t>(n_frames), 0.0f) {}
+
+            int n_mels() const override { return n_mels_; }
+            int n_frames() const override { return n_frames_; }
+            float* input_buffer() override { return input_.data(); }
+            int step_frames() const override { return step_; }
+            void ResetState() override { std::fill(state_.begin(), state_.end(), 0.0f); }
+
+            bool Infer(float* p_detect) override {
+                std::rotate(state_.begin(), state_.begin() + step_, state_.end());
+                for (int f = 0; f < step_; ++f) {
+                    state_[static_cast<std::size_t>(n_frames_ - step_ + f)] = input_[static_cast<std::size_t>(f * n_mels_)];
+                }
+                float sum = 0.0f;
+                for (float v : state_) sum += v;
+                std::this_thread::sleep_for(cost_);  // one step of the model
+                *p_detect = sum / static_cast<float>(n_frames_);
+                return true;
+            }
+
+        private:
+            int n_mels_;
+            int n_frames_;
+            int step_;
+            std::chrono::microseconds cost_;
+            std::vector<float> input_;
+            std::vector<float> state_;
+        };
+
+        // Same loop as async_detector with a streaming model (0.1 ms per step): the worker
+        // feeds only new frames, every result equals the window mean of its window, and after
+        // a 400-frame gap it re-primes once instead of catching up. step > 1 with
+        // n_frames % step != 0 checks priming in whole steps.
+        bool RunStreamingDetector(const Options& opt, int step) {
+            const int n_mels = 128;
+            const int n_frames = 169;
+            const int frames_per_chunk = 2;
+            const auto chunk_period = std::chrono::microseconds(2000);
+            const std::int64_t frame_ns = 10'000'000;
+            const int chunks = std::max(500, opt.iters);
+            const int gap_frames = 400;
+
+            auto ring = std::make_shared<core::dsp::PcenRingBuffer>(n_mels, 1500);
+            FakeStreamModel model(n_mels, n_frames, step, std::chrono::microseconds(100));
+            core::detect::AsyncWindowDetector det(ring, &model);
+            if (!det.Start()) return false;
+
+            std::vector<float> frame(static_cast<std::size_t>(n_mels));
+            std::uint64_t seq = 0;
+            auto push = [&](int n) {
+                for (int k = 0; k < n; ++k, ++seq) {
+                    std::fill(frame.begin(), frame.end(), static_cast<float>(seq));
+                    ring->PushFrame(frame.data(), static_cast<std::int64_t>(seq) * frame_ns);
+                }
+            };
+
+            std::uint64_t results = 0;
+            std::uint64_t last_end = 0;
+            bool exact = true;
+            auto take = [&] {
+                core::detect::AsyncWindowDetector::Result r;
+                if (!det.TakeLatest(&r)) return;
+                ++results;
+                // window mean of frames [end - n_frames, end)
+                const double expect = static_cast<double>(r.window_end_seq) - (n_frames + 1) / 2.0;
+                exact = exact && r.window_end_seq > last_end && r.p_detect == static_cast<float>(expect) &&
+                    r.window_t_ns == static_cast<std::int64_t>(r.window_end_seq - 1) * frame_ns;
+                last_end = r.window_end_seq;
+            };
+
+            const auto start = std::chrono::steady_clock::now();
+            for (int c = 0; c < chunks; ++c) {
+                std::this_thread::sleep_until(start + chunk_period * c);
+                push(c == chunks / 2 ? gap_frames : frames_per_chunk);  // worker misses a stretch once
+                det.Post(ring->frames_written());
+                take();
+            }
+            det.Stop();
+            take();
+
+            const auto st = det.stats();
+            const double steps_per_result = st.inferred ? static_cast<double>(st.steps) / static_cast<double>(st.inferred) : 0.0;
+            std::printf("  posted %llu  inferred %llu  dropped %llu  skipped %llu  taken %llu\n",
+                static_cast<unsigned long long>(st.posted), static_cast<unsigned long long>(st.inferred),
+                static_cast<unsigned long long>(st.dropped), static_cast<unsigned long long>(st.skipped),
+                static_cast<unsigned long long>(results));
+            std::printf("  step %d: %llu steps (%.1f frames per result vs %d for a window model)  resets %llu  exact %s\n",
+                step, static_cast<unsigned long long>(st.steps), steps_per_result * step, n_frames,
+                static_cast<unsigned long long>(st.resets), exact ? "yes" : "NO");
+
+            // resets: start-up and the gap; frames fed = 2 primings (whole steps) + everything else once
+            const std::uint64_t prime = static_cast<std::uint64_t>((n_frames + step - 1) / step * step);
+            const std::uint64_t max_frames = 2u * prime + seq - static_cast<std::uint64_t>(gap_frames);
+            return exact && results > 0 && st.resets == 2 && st.failed == 0 &&
+                st.steps * static_cast<std::uint64_t>(step) <= max_frames &&
+                steps_per_result * step < static_cast<double>(n_frames) / 10.0;
+        }
+
+        bool RunStreamingDetectorStep1(const Options& opt) { return RunStreamingDetector(opt, 1); }
+        bool RunStreamingDetectorStep3(const Options& opt) { return RunStreamingDetector(opt, 3); }
+
+    }  // namespace
+
+    std::vector<Case> DetectCases() {
+        return {
+            { "async_detector", "AsyncWindowDetector: slow model off the audio loop, stale windows dropped, exact windows", &RunAsyncDetector },
+            { "streaming_detector", "AsyncWindowDetector with a streaming model: only new frames fed, exact window scores",
+                &RunStreamingDetectorStep1 },
+            { "streaming_detector_step3", "streaming_detector with 3 frames per step (169 % 3 != 0)",
+                &RunStreamingDetectorStep3 },
+        };
+    }
+
+}  // namespace bench
@@ -0,0 +1,657 @@
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+
+#include "core/dsp/fft_kernels.h"
+#include "core/dsp/fft_plan.h"
+#include "core/dsp/fft_radix2.h"
+#include "core/dsp/mel_filterbank.h"
+#include "core/dsp/pcen_config.h"
+#include "core/dsp/pcen_extractor.h"
+#include "core/dsp/pcen_extractor_t.h"
+#include "core/dsp/pcen_kernel.h"
+#include "core/dsp/quantize_kernel.h"
+#include "core/dsp/real_fft.h"
+
+namespace bench {
+
+    namespace {
+
+        // FftPlan under every kernel set the host can run (scalar / SSE2 / AVX2+FMA / NEON,
+        // same table UAV_FFT_ISA picks from) against a double-precision DFT, n = 16..2048
+        // (odd log2(n) takes the extra radix-2 pass), in-place and out-of-place; then time
+        // per 1024-point transform next to the one-shot FftRadix2.
+        bool RunFftKernels(const Options& opt) {
+            constexpr double kBound = 1e-6;  // max |X - X_ref| / max |X_ref|; measured ~1.5e-7
+
+            std::mt19937 rng(99);
+            std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+            auto dft = [](const std::vector<std::complex<float>>& x) {
+                const std::size_t n = x.size();
+                std::vector<std::complex<double>> out(n);
+                for (std::size_t k = 0; k < n; ++k) {
+                    std::complex<double> acc = 0.0;
+                    for (std::size_t t = 0; t < n; ++t) {
+                        const double ang = -2.0 * 3.14159265358979323846 * static_cast<double>((k * t) % n) / static_cast<double>(n);
+                        acc += std::complex<double>(x[t]) * std::complex<double>(std::cos(ang), std::sin(ang));
+                    }
+                    out[k] = acc;
+                }
+                return out;
+            };
+            auto rel_error = [](const std::vector<std::complex<float>>& got, const std::vector<std::complex<double>>& ref) {
+                double err = 0.0;
+                double peak = 0.0;
+                for (std::size_t k = 0; k < ref.size(); ++k) {
+                    err = std::max(err, std::abs(std::complex<double>(got[k]) - ref[k]));
+                    peak = std::max(peak, std::abs(ref[k]));
+                }
+                return err / std::max(peak, 1e-30);
+            };
+
+            std::vector<std::vector<std::complex<float>>> inputs;
+            std::vector<std::vector<std::complex<double>>> refs;
+            for (int n = 16; n <= 2048; n *= 2) {
+                std::vector<std::complex<float>> x(static_cast<std::size_t>(n));
+                for (auto& v : x) v = { dist(rng), dist(rng) };
+                refs.push_back(dft(x));
+                inputs.push_back(std::move(x));
+            }
+
+            bool ok = true;
+            double worst_radix2 = 0.0;
+            for (std::size_t i = 0; i < inputs.size(); ++i) {
+                std::vector<std::complex<float>> y = inputs[i];
+                core::dsp::FftRadix2(y);
+                worst_radix2 = std::max(worst_radix2, rel_error(y, refs[i]));
+            }
+
+            constexpr int kTimeN = 1024;
+            std::vector<std::complex<float>> tin(kTimeN), tout(kTimeN);
+            for (auto& v : tin) v = { dist(rng), dist(rng) };
+            std::vector<std::complex<float>> tvec = tin;
+            const double us_radix2 = TimeUs(opt.iters, [&] {
+                tvec = tin;
+                core::dsp::FftRadix2(tvec);
+                });
+
+            std::printf("%-8s %12s %14s\n", "kernels", "max rel err", "us / 1024-pt");
+            std::printf("%-8s %12.3g %14.3f  (one-shot FftRadix2, reference for timing)\n", "radix2", worst_radix2, us_radix2);
+            for (core::dsp::SimdIsa isa : { core::dsp::SimdIsa::kScalar, core::dsp::SimdIsa::kSse2,
+                                             core::dsp::SimdIsa::kAvx2, core::dsp::SimdIsa::kNeon }) {
+                const core::dsp::FftKernels* k = core::dsp::GetFftKernels(isa);
+                if (!k) {
+                    std::printf("%-8s %12s\n", core::dsp::SimdIsaName(isa), "n/a");
+                    continue;
+                }
+
+                double worst = 0.0;
+                for (std::size_t i = 0; i < inputs.size(); ++i) {
+                    const core::dsp::FftPlan plan(static_cast<int>(inputs[i].size()), k);
+                    std::vector<std::complex<float>> in_place = inputs[i];
+                    std::vector<std::complex<float>> out_of_place(inputs[i].size());
+                    plan.Forward(in_place.data());
+                    plan.Forward(inputs[i].data(), out_of_place.data());
+                    worst = std::max({ worst, rel_error(in_place, refs[i]), rel_error(out_of_place, refs[i]) });
+                }
+
+                const core::dsp::FftPlan plan(kTimeN, k);
+                const double us = TimeUs(opt.iters, [&] { plan.Forward(tin.data(), tout.data()); });
+                std::printf("%-8s %12.3g %14.3f  (x%.1f)\n", core::dsp::SimdIsaName(isa), worst, us, us_radix2 / us);
+                ok = ok && worst <= kBound;
+            }
+            std::printf("bound %.0e; active kernels: %s\n", kBound, core::dsp::SimdIsaName(core::dsp::ActiveFftKernels().isa));
+            return ok;
+        }
+
+        // Fast PCEN compression vs the std::pow reference: error over a parameter grid
+        // (the range documented in pcen_kernel.h), then timing with default params.
+        bool RunPcenKernel(const Options& opt) {
+            constexpr std::size_t kCount = 1u << 14;
+            constexpr double kBound = 4e-6;
+
+            std::mt19937 rng(12345);
+            std::uniform_real_distribution<float> log_mag(-12.0f, 6.0f);
+
+            std::vector<float> E(kCount), M(kCount), fast(kCount), ref(kCount);
+            for (std::size_t i = 0; i < kCount; ++i) {
+                E[i] = std::pow(10.0f, log_mag(rng));
+                M[i] = (i % 7 == 0) ? 0.0f : std::pow(10.0f, log_mag(rng));
+            }
+
+            const float alphas[] = { 0.0f, 0.25f, 0.5f, 0.7f, 0.98f, 1.0f };
+            const float rs[] = { 0.1f, 0.25f, 0.5f, 0.7f, 1.0f };
+            const float deltas[] = { 0.5f, 2.0f, 10.0f };
+
+            double worst = 0.0;
+            for (float alpha : alphas) {
+                for (float r : rs) {
+                    for (float delta : deltas) {
+                        core::dsp::PcenConfig cfg;
+                        cfg.alpha = alpha;
+                        cfg.r = r;
+                        cfg.delta = delta;
+                        cfg.floor = 0.0f;
+                        const core::dsp::PcenKernel kernel(cfg);
+                        kernel.Compress(E.data(), M.data(), fast.data(), kCount);
+                        kernel.CompressReference(E.data(), M.data(), ref.data(), kCount);
+
+                        for (std::size_t i = 0; i < kCount; ++i) {
+                            const double err = std::fabs(static_cast<double>(fast[i]) - ref[i]) /
+                                std::max(1.0, std::fabs(static_cast<double>(ref[i])));
+                            worst = std::max(worst, err);
+                        }
+                    }
+                }
+            }
+            std::printf("max rel error   %.3g (bound %.1g)\n", worst, kBound);
+
+            const core::dsp::PcenConfig cfg;
+            const core::dsp::PcenKernel kernel(cfg);
+            const double us_ref = TimeUs(opt.iters, [&] {
+                kernel.CompressReference(E.data(), M.data(), ref.data(), kCount);
+                });
+            const double us_fast = TimeUs(opt.iters, [&] {
+                kernel.Compress(E.data(), M.data(), fast.data(), kCount);
+                });
+            std::printf("reference       %8.2f us / %zu values\n", us_ref, kCount);
+            std::printf("fast            %8.2f us / %zu values (x%.2f)\n", us_fast, kCount, us_ref / us_fast);
+
+            return worst <= kBound;
+        }
+
+        // Mel filterbank as it was first written: dense [n_mels][n_freqs] matrix, triangles
+        // between mel-spaced bin edges; Apply is a full dot product per mel.
+        std::vector<float> LegacyMelWeights(const core::dsp::MelFilterbankConfig& cfg) {
+            const int n_freqs = cfg.n_fft / 2 + 1;
+            std::vector<float> w(static_cast<std::size_t>(cfg.n_mels * n_freqs), 0.0f);
+
+            auto hz_to_mel = [](float hz) { return 2595.0f * std::log10(1.0f + hz / 700.0f); };
+            auto mel_to_hz = [](float mel) { return 700.0f * (std::pow(10.0f, mel / 2595.0f) - 1.0f); };
+            const float mel_min = hz_to_mel(std::max(0.0f, cfg.f_min));
+            const float mel_max = hz_to_mel(std::min(cfg.f_max, 0.5f * static_cast<float>(cfg.sample_rate)));
+
+            std::vector<int> bin(static_cast<std::size_t>(cfg.n_mels + 2));
+            for (int i = 0; i < cfg.n_mels + 2; ++i) {
+                const float t = static_cast<float>(i) / static_cast<float>(cfg.n_mels + 1);
+                const float hz = mel_to_hz(mel_min + t * (mel_max - mel_min));
+                const int b = static_cast<int>(std::floor((cfg.n_fft + 1) * hz / cfg.sample_rate));
+                bin[static_cast<std::size_t>(i)] = std::clamp(b, 0, n_freqs - 1);
+            }
+
+            for (int m = 0; m < cfg.n_mels; ++m) {
+                const int left = bin[static_cast<std::size_t>(m)];
+                const int center = bin[static_cast<std::size_t>(m + 1)];
+                const int right = bin[static_cast<std::size_t>(m + 2)];
+                if (right <= left) continue;
+
+                float* row = &w[static_cast<std::size_t>(m * n_freqs)];
+                for (int k = left; k < center; ++k) {
+                    row[k] = static_cast<float>(k - left) / static_cast<float>(center - left);
+                }
+                for (int k = center; k <= right; ++k) {
+                    const float denom = static_cast<float>(right - center);
+                    row[k] = std::max(row[k], denom > 0.0f ? static_cast<float>(right - k) / denom : 0.0f);
+                }
+            }
+            return w;
+        }
+
+        void LegacyMelApply(const std::vector<float>& w, int n_mels, int n_freqs, const float* power, float* out_mel) {
+            for (int m = 0; m < n_mels; ++m) {
+                const float* row = &w[static_cast<std::size_t>(m * n_freqs)];
+                float acc = 0.0f;
+                for (int k = 0; k < n_freqs; ++k) acc += row[k] * power[k];
+                out_mel[m] = acc;
+            }
+        }
+
+        // PcenExtractor before the real FFT / plan / banded mel / batching / ring buffer work:
+        // one frame at a time, Hann window into a zeroed complex buffer, full n_fft FftRadix2,
+        // dense mel, std::pow PCEN, input FIFO popped with erase(). Kept here as the reference.
+        class LegacyPcenExtractor {
+        public:
+            explicit LegacyPcenExtractor(const core::dsp::PcenConfig& cfg)
+                : cfg_(cfg),
+                n_freqs_(cfg.n_fft / 2 + 1),
+                mel_w_(LegacyMelWeights({ cfg.sample_rate, cfg.n_fft, cfg.n_mels, cfg.f_min, cfg.f_max })),
+                window_(static_cast<std::size_t>(cfg.win_length)),
+                fft_buf_(static_cast<std::size_t>(cfg.n_fft)),
+                power_(static_cast<std::size_t>(n_freqs_)),
+                mel_energy_(static_cast<std::size_t>(cfg.n_mels)),
+                pcen_m_(static_cast<std::size_t>(cfg.n_mels), 0.0f),
+                pcen_frame_(static_cast<std::size_t>(cfg.n_mels)) {
+                for (int i = 0; i < cfg_.win_length; ++i) {
+                    const float x = static_cast<float>(i) / static_cast<float>(cfg_.win_length - 1);
+                    window_[static_cast<std::size_t>(i)] = 0.5f - 0.5f * std::cos(2.0f * core::dsp::kPi * x);
+                }
+            }
+
+            int Process(const float* mono, int n, std::vector<float>* out_frames) {
+                fifo_.insert(fifo_.end(), mono, mono + n);
+                int produced = 0;
+                while (static_cast<int>(fifo_.size()) >= cfg_.win_length) {
+                    OneFrame(fifo_.data(), pcen_frame_.data());
+                    out_frames->insert(out_frames->end(), pcen_frame_.begin(), pcen_frame_.end());
+                    ++produced;
+                    if (static_cast<int>(fifo_.size()) <= cfg_.hop_length) {
+                        fifo_.clear();
+                        break;
+                    }
+                    fifo_.erase(fifo_.begin(), fifo_.begin() + cfg_.hop_length);
+                }
+                return produced;
+            }
+
+        private:
+            void OneFrame(const float* frame_win, float* out_pcen) {
+                std::fill(fft_buf_.begin(), fft_buf_.end(), std::complex<float>(0.0f, 0.0f));
+                for (int i = 0; i < cfg_.win_length; ++i) {
+                    fft_buf_[static_cast<std::size_t>(i)] = { frame_win[i] * window_[static_cast<std::size_t>(i)], 0.0f };
+                }
+                core::dsp::FftRadix2(fft_buf_);
+
+                const float inv_n = 1.0f / static_cast<float>(cfg_.n_fft);
+                for (int k = 0; k < n_freqs_; ++k) {
+                    const auto c = fft_buf_[static_cast<std::size_t>(k)] * inv_n;
+                    power_[static_cast<std::size_t>(k)] = std::max(cfg_.floor, c.real() * c.real() + c.imag() * c.imag());
+                }
+
+                LegacyMelApply(mel_w_, cfg_.n_mels, n_freqs_, power_.data(), mel_energy_.data());
+
+                const float delta_r = std::pow(cfg_.delta, cfg_.r);
+                for (int m = 0; m < cfg_.n_mels; ++m) {
+                    const float e = std::max(cfg_.floor, mel_energy_[static_cast<std::size_t>(m)]);
+                    float& sm = pcen_m_[static_cast<std::size_t>(m)];
+                    sm = (1.0f - cfg_.s) * sm + cfg_.s * e;
+                    out_pcen[m] = std::pow(e / std::pow(cfg_.eps + sm, cfg_.alpha) + cfg_.delta, cfg_.r) - delta_r;
+                }
+            }
+
+            core::dsp::PcenConfig cfg_;
+            int n_freqs_ = 0;
+            std::vector<float> mel_w_;
+            std::vector<float> window_;
+            std::vector<float> fifo_;
+            std::vector<std::complex<float>> fft_buf_;
+            std::vector<float> power_;
+            std::vector<float> mel_energy_;
+            std::vector<float> pcen_m_;
+            std::vector<float> pcen_frame_;
+        };
+
+        core::dsp::PcenConfig ProductionPcenConfig() {
+            core::dsp::PcenConfig cfg;
+            cfg.sample_rate = 22050;
+            cfg.n_fft = 1024;
+            cfg.win_length = 1024;
+            cfg.hop_length = 256;
+            cfg.n_mels = 128;
+            cfg.alpha = 0.6f;
+            cfg.delta = 2.0f;
+            cfg.r = 0.1f;
+            cfg.s = 0.014f;
+            return cfg;
+        }
+
+        std::vector<float> NoiseSignal(std::size_t n, std::uint32_t seed) {
+            std::mt19937 rng(seed);
+            std::uniform_real_distribution<float> noise(-0.3f, 0.3f);
+            std::vector<float> sig(n);
+            for (auto& v : sig) v = noise(rng);
+            return sig;
+        }
+
+        template <class Extractor>
+        void FeedChunks(Extractor& ex, const std::vector<float>& sig, std::size_t chunk, std::vector<float>* out) {
+            out->clear();
+            for (std::size_t off = 0; off < sig.size(); off += chunk) {
+                const int n = static_cast<int>(std::min(chunk, sig.size() - off));
+                ex.Process(sig.data() + off, n, out);
+            }
+        }
+
+        double MaxAbsDiff(const std::vector<float>& a, const std::vector<float>& b) {
+            double worst = 0.0;
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                worst = std::max(worst, std::fabs(static_cast<double>(a[i]) - b[i]));
+            }
+            return worst;
+        }
+
+        // PcenExtractor (real FFT, plan, banded mel, batching, ring buffer; std::pow PCEN so
+        // only the spectrum path differs) against LegacyPcenExtractor, 10 s of noise in 20 ms
+        // chunks, for the production shape and the PcenConfig defaults (win < n_fft); batched
+        // vs frame-by-frame output; chunking invariance (incl. hop > win); the banded
+        // mel projection against the dense matrix; then the per-frame FFT cost (complex FftRadix2 and FftPlan on zero-imaginary input vs
+        // RealFft) and the whole extractor.
+        bool RunPcenExtractor(const Options& opt) {
+            constexpr double kBound = 1e-5;  // measured ~4e-6 (defaults, r = 0.5), ~1e-7 production
+            constexpr double kMelBound = 1e-5;
+            bool ok = true;
+
+            core::dsp::PcenConfig configs[2] = { ProductionPcenConfig(), core::dsp::PcenConfig{} };
+            for (auto& cfg : configs) {
+                cfg.fast_pcen = false;
+                const std::vector<float> sig = NoiseSignal(static_cast<std::size_t>(cfg.sample_rate) * 10, 777);
+                const std::size_t chunk = static_cast<std::size_t>(cfg.sample_rate / 50);
+
+                std::vector<float> out_new, out_old;
+                core::dsp::PcenExtractor ex(cfg);
+                LegacyPcenExtractor legacy(cfg);
+                FeedChunks(ex, sig, chunk, &out_new);
+                FeedChunks(legacy, sig, chunk, &out_old);
+                if (out_new.size() != out_old.size() || out_new.empty()) {
+                    std::printf("frame count mismatch: %zu vs %zu\n", out_new.size(), out_old.size());
+                    return false;
+                }
+                const double worst = MaxAbsDiff(out_new, out_old);
+                std::printf("%5d/%4d/%4d/%3d mels: %zu frames, max abs diff vs legacy %.3g\n",
+                    cfg.sample_rate, cfg.n_fft, cfg.win_length, cfg.n_mels,
+                    out_new.size() / static_cast<std::size_t>(cfg.n_mels), worst);
+                ok = ok && worst <= kBound;
+            }
+
+            // Batching (max_batch_frames 8 vs 1) must not change a single bit: one Process()
+            // call with the whole signal takes the batched path for every full group of hops.
+            for (const bool fast : { false, true }) {
+                core::dsp::PcenConfig cfg = ProductionPcenConfig();
+                cfg.fast_pcen = fast;
+                const std::vector<float> sig = NoiseSignal(static_cast<std::size_t>(cfg.sample_rate) * 5, 31);
+                std::vector<float> out_batch, out_single;
+                cfg.max_batch_frames = 8;
+                core::dsp::PcenExtractor batched(cfg);
+                FeedChunks(batched, sig, sig.size(), &out_batch);
+                cfg.max_batch_frames = 1;
+                core::dsp::PcenExtractor single(cfg);
+                FeedChunks(single, sig, sig.size(), &out_single);
+                const bool same = !out_batch.empty() && out_batch == out_single;
+                std::printf("batch 8 vs 1 (%s PCEN): %zu frames, %s\n", fast ? "fast" : "std::pow",
+                    out_batch.size() / static_cast<std::size_t>(cfg.n_mels), same ? "identical" : "DIFFERENT");
+                ok = ok && same;
+            }
+
+            // The circular input buffer must make the output independent of how the signal is
+            // chunked: chunks shorter than the window, not a multiple of hop, and one call with
+            // everything, all bit-identical. Also hop > win (samples between windows skipped).
+            core::dsp::PcenConfig chunk_cfgs[2] = { ProductionPcenConfig(), core::dsp::PcenConfig{} };
+            chunk_cfgs[1].hop_length = 600;  // win 400
+            for (auto& cfg : chunk_cfgs) {
+                cfg.fast_pcen = false;
+                const std::vector<float> sig = NoiseSignal(static_cast<std::size_t>(cfg.sample_rate) * 3, 99);
+                std::vector<float> whole, chunked;
+                {
+                    core::dsp::PcenExtractor ex(cfg);
+                    FeedChunks(ex, sig, sig.size(), &whole);
+                }
+                const std::size_t expect_frames = (sig.size() - static_cast<std::size_t>(cfg.win_length)) /
+                    static_cast<std::size_t>(cfg.hop_length) + 1;
+                bool same = whole.size() == expect_frames * static_cast<std::size_t>(cfg.n_mels);
+                for (const std::size_t chunk : { 1, 7, 100, 333, 441, 4410 }) {
+                    core::dsp::PcenExtractor ex(cfg);
+                    FeedChunks(ex, sig, chunk, &chunked);
+                    same = same && chunked == whole;
+                }
+
+                // hop > win: the same frames as the original extractor (hop = win) fed only the
+                // windows, back to back
+                double worst = 0.0;
+                if (cfg.hop_length > cfg.win_length) {
+                    std::vector<float> windows;
+                    for (std::size_t off = 0; off + static_cast<std::size_t>(cfg.win_length) <= sig.size();
+                        off += static_cast<std::size_t>(cfg.hop_length)) {
+                        windows.insert(windows.end(), sig.begin() + static_cast<std::ptrdiff_t>(off),
+                            sig.begin() + static_cast<std::ptrdiff_t>(off) + cfg.win_length);
+                    }
+                    core::dsp::PcenConfig ref_cfg = cfg;
+                    ref_cfg.hop_length = cfg.win_length;
+                    LegacyPcenExtractor legacy(ref_cfg);
+                    std::vector<float> ref;
+                    FeedChunks(legacy, windows, windows.size(), &ref);
+                    same = same && ref.size() == whole.size();
+                    if (same) worst = MaxAbsDiff(whole, ref);
+                }
+                std::printf("chunks 1..4410, win %4d hop %3d: %zu frames, %s", cfg.win_length, cfg.hop_length,
+                    whole.size() / static_cast<std::size_t>(cfg.n_mels), same ? "identical" : "DIFFERENT");
+                if (cfg.hop_length > cfg.win_length) std::printf(", max abs diff vs legacy on windows %.3g", worst);
+                std::printf("\n");
+                ok = ok && same && worst <= kBound;
+            }
+
+            // Banded MelFilterbank vs the dense matrix on random power spectra (log-uniform
+            // over 1e-12..1e2), Apply and ApplyBatch; the last shape has empty and one-bin bands.
+            const core::dsp::MelFilterbankConfig mel_cfgs[3] = {
+                { 22050, 1024, 128, 50.0f, 7600.0f },
+                { 16000, 512, 64, 50.0f, 7600.0f },
+                { 16000, 256, 96, 0.0f, 8000.0f },
+            };
+            std::mt19937 rng(2024);
+            std::uniform_real_distribution<float> log_power(-12.0f, 2.0f);
+            for (const auto& mc : mel_cfgs) {
+                constexpr int kFrames = 8;
+                const core::dsp::MelFilterbank banded(mc);
+                const std::vector<float> dense = LegacyMelWeights(mc);
+                const int n_freqs = banded.n_freqs();
+
+                std::vector<float> power(static_cast<std::size_t>(kFrames * n_freqs));
+                for (auto& v : power) v = std::pow(10.0f, log_power(rng));
+                std::vector<float> ref(static_cast<std::size_t>(kFrames * mc.n_mels));
+                std::vector<float> one(ref.size()), batch(ref.size());
+                for (int f = 0; f < kFrames; ++f) {
+                    const std::size_t p_off = static_cast<std::size_t>(f * n_freqs);
+                    const std::size_t m_off = static_cast<std::size_t>(f * mc.n_mels);
+                    LegacyMelApply(dense, mc.n_mels, n_freqs, power.data() + p_off, ref.data() + m_off);
+                    banded.Apply(power.data() + p_off, one.data() + m_off);
+                }
+                banded.ApplyBatch(power.data(), kFrames, batch.data());
+
+                // relative to the band sum (summation order differs)
+                double worst = 0.0;
+                for (std::size_t i = 0; i < ref.size(); ++i) {
+                    const double scale = std::max(static_cast<double>(std::fabs(ref[i])), 1e-30);
+                    worst = std::max({ worst, std::fabs(one[i] - ref[i]) / scale, std::fabs(batch[i] - ref[i]) / scale });
+                }
+                const double us_dense = TimeUs(opt.iters, [&] { LegacyMelApply(dense, mc.n_mels, n_freqs, power.data(), ref.data()); });
+                const double us_banded = TimeUs(opt.iters, [&] { banded.Apply(power.data(), one.data()); });
+                std::printf("mel %5d/%4d/%3d: %5d of %6d weights, max rel diff %.3g, Apply dense %6.2f us, banded %6.2f us (x%.1f)\n",
+                    mc.sample_rate, mc.n_fft, mc.n_mels, banded.n_weights(), mc.n_mels * n_freqs,
+                    worst, us_dense, us_banded, us_dense / us_banded);
+                ok = ok && worst <= kMelBound;
+            }
+
+            const core::dsp::PcenConfig cfg = ProductionPcenConfig();
+            const std::vector<float> frame = NoiseSignal(static_cast<std::size_t>(cfg.n_fft), 5);
+            std::vector<std::complex<float>> cbuf(frame.size());
+            std::vector<std::complex<float>> bins(static_cast<std::size_t>(cfg.n_fft / 2 + 1));
+            const core::dsp::FftPlan cplan(cfg.n_fft);
+            core::dsp::RealFft rfft(cfg.n_fft);
+            const double us_cfft = TimeUs(opt.iters, [&] {
+                for (std::size_t i = 0; i < frame.size(); ++i) cbuf[i] = { frame[i], 0.0f };
+                core::dsp::FftRadix2(cbuf);
+                });
+            const double us_cplan = TimeUs(opt.iters, [&] {
+                for (std::size_t i = 0; i < frame.size(); ++i) cbuf[i] = { frame[i], 0.0f };
+                cplan.Forward(cbuf.data());
+                });
+            const double us_rfft = TimeUs(opt.iters, [&] { rfft.Forward(frame.data(), bins.data()); });
+
+            const std::vector<float> sig = NoiseSignal(static_cast<std::size_t>(cfg.sample_rate) * 10, 777);
+            const std::size_t chunk = static_cast<std::size_t>(cfg.sample_rate / 50);
+            std::vector<float> out_new, out_old;
+            out_new.reserve(sig.size());
+            out_old.reserve(sig.size());
+            const int iters = std::max(1, opt.iters / 20);
+            const double us_old = TimeUs(iters, [&] {
+                LegacyPcenExtractor legacy(cfg);
+                FeedChunks(legacy, sig, chunk, &out_old);
+                });
+            const double us_new = TimeUs(iters, [&] {
+                core::dsp::PcenExtractor ex(cfg);
+                FeedChunks(ex, sig, chunk, &out_new);
+                });
+            const double frames = static_cast<double>(out_new.size() / static_cast<std::size_t>(cfg.n_mels));
+
+            std::printf("bounds %.0e frames, %.0e mel\n", kBound, kMelBound);
+            std::printf("FFT %d: FftRadix2 %8.2f us, FftPlan (complex) %8.2f us, RealFft %8.2f us (x%.2f, x%.2f)\n",
+                cfg.n_fft, us_cfft, us_cplan, us_rfft, us_cfft / us_rfft, us_cplan / us_rfft);
+            std::printf("per frame:  legacy %8.2f us, PcenExtractor %8.2f us (x%.2f)\n",
+                us_old / frames, us_new / frames, us_old / us_new);
+            return ok;
+        }
+
+        // Production shape (main.cpp): generic PcenExtractor vs PcenExtractorT, 10 s of noise in 20 ms chunks
+        bool RunPcenExtractorT(const Options& opt) {
+            constexpr int kSampleRate = 22050;
+            constexpr int kChunk = kSampleRate / 50;
+            constexpr double kBound = 1e-5;
+
+            core::dsp::PcenConfig cfg;
+            cfg.sample_rate = kSampleRate;
+            cfg.n_fft = 1024;
+            cfg.win_length = 1024;
+            cfg.hop_length = 256;
+            cfg.n_mels = 128;
+            cfg.alpha = 0.6f;
+            cfg.delta = 2.0f;
+            cfg.r = 0.1f;
+            cfg.s = 0.014f;
+            using Fixed = core::dsp::PcenExtractorT<1024, 128, 256, kSampleRate>;
+
+            std::mt19937 rng(777);
+            std::uniform_real_distribution<float> noise(-0.3f, 0.3f);
+            std::vector<float> sig(static_cast<std::size_t>(kSampleRate) * 10);
+            for (auto& v : sig) v = noise(rng);
+
+            auto feed = [&](auto& ex, std::vector<float>* out) {
+                out->clear();
+                for (std::size_t off = 0; off < sig.size(); off += kChunk) {
+                    const int n = static_cast<int>(std::min<std::size_t>(kChunk, sig.size() - off));
+                    ex.Process(sig.data() + off, n, out);
+                }
+            };
+
+            std::vector<float> out_gen, out_fix;
+            out_gen.reserve(sig.size());
+            out_fix.reserve(sig.size());
+            {
+                core::dsp::PcenExtractor gen(cfg);
+                Fixed fix(core::dsp::ParamsOf(cfg));
+                feed(gen, &out_gen);
+                feed(fix, &out_fix);
+            }
+            if (out_gen.size() != out_fix.size() || out_gen.empty()) {
+                std::printf("frame count mismatch: %zu vs %zu\n", out_gen.size(), out_fix.size());
+                return false;
+            }
+            double worst = 0.0;
+            for (std::size_t i = 0; i < out_gen.size(); ++i) {
+                worst = std::max(worst, std::fabs(static_cast<double>(out_gen[i]) - out_fix[i]));
+            }
+            const double frames = static_cast<double>(out_gen.size() / 128);
+
+            const int iters = std::max(1, opt.iters / 20);
+            const double us_gen = TimeUs(iters, [&] {
+                core::dsp::PcenExtractor gen(cfg);
+                feed(gen, &out_gen);
+                });
+            const double us_fix = TimeUs(iters, [&] {
+                Fixed fix(core::dsp::ParamsOf(cfg));
+                feed(fix, &out_fix);
+                });
+
+            std::printf("max abs diff    %.3g (bound %.0e)\n", worst, kBound);
+            std::printf("PcenExtractor   %8.2f us / frame\n", us_gen / frames);
+            std::printf("PcenExtractorT  %8.2f us / frame (x%.2f)\n", us_fix / frames, us_gen / us_fix);
+            return worst <= kBound;
+        }
+
+
+        // int8/uint8 window quantization (TcnDetector with a fully quantized model): SIMD vs
+        // the scalar reference must match exactly, round trip within scale / 2; timed on a
+        // 128x169 window
+        bool RunQuantizeKernel(const Options& opt) {
+            constexpr std::size_t kCount = 128 * 169;
+
+            std::mt19937 rng(4242);
+            std::uniform_real_distribution<float> pcen(-0.5f, 6.0f);
+            std::vector<float> x(kCount);
+            for (auto& v : x) v = pcen(rng);
+            // saturation, NaN and ties at the head; odd count leaves a scalar tail
+            const float edges[] = { std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity(),
+                -std::numeric_limits<float>::infinity(), 1e9f, -1e9f, 0.0f, -0.0f };
+            std::copy(std::begin(edges), std::end(edges), x.begin());
+            const std::size_t n = kCount - 3;
+
+            const core::dsp::QuantParams q8{ 6.6f / 255.0f, -108 };  // int8, covers [-0.5, 6]
+            const core::dsp::QuantParams qu8{ 6.6f / 255.0f, 20 };   // uint8, same range
+            for (std::size_t i = 0; i < 16; ++i) {                    // exact .5 ties
+                x[16 + i] = (static_cast<float>(i) - 7.5f) * q8.scale;
+            }
+
+            std::vector<std::int8_t> s8(kCount), r8(kCount);
+            std::vector<std::uint8_t> su8(kCount), ru8(kCount);
+            std::vector<float> back(kCount);
+            core::dsp::QuantizeInt8(x.data(), n, q8, s8.data());
+            core::dsp::QuantizeInt8Reference(x.data(), n, q8, r8.data());
+            core::dsp::QuantizeUint8(x.data(), n, qu8, su8.data());
+            core::dsp::QuantizeUint8Reference(x.data(), n, qu8, ru8.data());
+
+            std::size_t mismatch = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                if (s8[i] != r8[i] || su8[i] != ru8[i]) ++mismatch;
+            }
+            const bool sat_ok = s8[1] == 127 && s8[2] == -128 && s8[0] == -128 && su8[1] == 255 && su8[2] == 0 &&
+                s8[5] == q8.zero_point && su8[6] == qu8.zero_point;
+
+            auto round_trip = [&](const auto& qv, const core::dsp::QuantParams& q, auto dequant) {
+                dequant(qv.data(), n, q, back.data());
+                double worst = 0.0;
+                for (std::size_t i = 32; i < n; ++i) {  // in-range values only
+                    worst = std::max(worst, std::fabs(static_cast<double>(back[i]) - x[i]));
+                }
+                return worst / q.scale;
+                };
+            const double err8 = round_trip(s8, q8, &core::dsp::DequantizeInt8);
+            const double erru8 = round_trip(su8, qu8, &core::dsp::DequantizeUint8);
+
+            std::printf("simd vs scalar  %zu mismatches, saturation %s\n", mismatch, sat_ok ? "ok" : "WRONG");
+            std::printf("round trip      int8 %.3f, uint8 %.3f (x scale, bound 0.5)\n", err8, erru8);
+
+            const double us_ref = TimeUs(opt.iters, [&] {
+                core::dsp::QuantizeInt8Reference(x.data(), kCount, q8, r8.data());
+                });
+            const double us_simd = TimeUs(opt.iters, [&] {
+                core::dsp::QuantizeInt8(x.data(), kCount, q8, s8.data());
+                });
+            const double us_deq = TimeUs(opt.iters, [&] {
+                core::dsp::DequantizeInt8(s8.data(), kCount, q8, back.data());
+                });
+            std::printf("reference       %8.2f us / %zu values\n", us_ref, kCount);
+            std::printf("simd            %8.2f us / %zu values (x%.2f)\n", us_simd, kCount, us_ref / us_simd);
+            std::printf("dequantize      %8.2f us / %zu values\n", us_deq, kCount);
+
+            return mismatch == 0 && sat_ok && err8 <= 0.5 + 1e-3 && erru8 <= 0.5 + 1e-3;
+        }
+
+    }  // namespace
+
+    std::vector<Case> DspCases() {
+        return {
+            { "fft_kernels", "FftPlan per SIMD kernel set vs double DFT (n = 16..2048) and speed vs FftRadix2", &RunFftKernels },
+            { "pcen_kernel", "fast PCEN compression: accuracy vs std::pow and speed", &RunPcenKernel },
+            { "pcen_extractor", "PcenExtractor vs the original frame-by-frame algorithm (complex FFT, dense mel) and speed", &RunPcenExtractor },
+            { "pcen_extractor_t", "compile-time specialized extractor vs PcenExtractor (1024/128/256 @ 22050)", &RunPcenExtractorT },
+            { "quantize_kernel", "int8/uint8 window quantization: SIMD vs scalar and speed", &RunQuantizeKernel },
+        };
+    }
+
+}  // namespace bench
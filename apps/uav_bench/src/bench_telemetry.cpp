@@ -0,0 +1,447 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+
+#include "core/telemetry/latency_histogram.h"
+#include "core/telemetry/telemetry_bus.h"
+#include "core/telemetry/telemetry_recorder.h"
+#include "core/telemetry/telemetry_snapshot_pool.h"
+
+namespace bench {
+
+    namespace {
+
+        using core::telemetry::TelemetrySnapshot;
+        using SnapshotPtr = std::shared_ptr<const TelemetrySnapshot>;
+
+        // Previous TelemetryBus (mutexes, callbacks copied per publish), kept as the baseline
+        class MutexTelemetryBus {
+        public:
+            using Callback = std::function<void(SnapshotPtr)>;
+
+            void Publish(std::shared_ptr<TelemetrySnapshot> snapshot) {
+                SnapshotPtr frozen = std::move(snapshot);
+                {
+                    std::lock_guard<std::mutex> lk(latest_mu_);
+                    latest_ = std::move(frozen);
+                }
+                std::vector<Callback> callbacks;
+                {
+                    std::lock_guard<std::mutex> lk(subs_mu_);
+                    callbacks = subs_;
+                }
+                SnapshotPtr cur;
+                {
+                    std::lock_guard<std::mutex> lk(latest_mu_);
+                    cur = latest_;
+                }
+                for (auto& cb : callbacks) cb(cur);
+            }
+
+            SnapshotPtr Latest() const {
+                std::lock_guard<std::mutex> lk(latest_mu_);
+                return latest_;
+            }
+
+            void Subscribe(Callback cb) {
+                std::lock_guard<std::mutex> lk(subs_mu_);
+                subs_.push_back(std::move(cb));
+            }
+
+        private:
+            mutable std::mutex latest_mu_;
+            SnapshotPtr latest_;
+            std::mutex subs_mu_;
+            std::vector<Callback> subs_;
+        };
+
+        struct BusRunStats {
+            double p50_us = 0.0;
+            double p99_us = 0.0;
+            double max_us = 0.0;
+            long long reads = 0;
+            long long callbacks = 0;
+            bool ordered = true;  // readers never saw t_ns go backwards
+        };
+
+        // One publisher, `n_readers` threads polling Latest() (the GUI tick, at full speed),
+        // two subscribers. Snapshots are allocated up front so only Publish() is timed.
+        template <class Bus>
+        BusRunStats RunBus(Bus& bus, int n_publish, int n_readers) {
+            std::atomic<long long> callbacks{ 0 };
+            for (int i = 0; i < 2; ++i) {
+                (void)bus.Subscribe([&callbacks](SnapshotPtr s) {
+                    if (s) callbacks.fetch_add(1, std::memory_order_relaxed);
+                });
+            }
+
+            std::vector<std::shared_ptr<TelemetrySnapshot>> snaps(static_cast<std::size_t>(n_publish));
+            for (int i = 0; i < n_publish; ++i) {
+                snaps[static_cast<std::size_t>(i)] = std::make_shared<TelemetrySnapshot>();
+                snaps[static_cast<std::size_t>(i)]->t_ns = i + 1;
+            }
+
+            std::atomic<bool> done{ false };
+            std::atomic<long long> reads{ 0 };
+            std::atomic<bool> ordered{ true };
+            std::vector<std::thread> readers;
+            for (int r = 0; r < n_readers; ++r) {
+                readers.emplace_back([&] {
+                    long long local = 0;
+                    std::int64_t last_t = 0;
+                    while (!done.load(std::memory_order_relaxed)) {
+                        const auto s = bus.Latest();
+                        if (s) {
+                            if (s->t_ns < last_t) ordered = false;
+                            last_t = s->t_ns;
+                        }
+                        ++local;
+                    }
+                    reads += local;
+                });
+            }
+
+            std::vector<double> lat(static_cast<std::size_t>(n_publish));
+            for (int i = 0; i < n_publish; ++i) {
+                auto s = std::move(snaps[static_cast<std::size_t>(i)]);
+                const double t0 = NowUs();
+                bus.Publish(std::move(s));
+                lat[static_cast<std::size_t>(i)] = NowUs() - t0;
+                if ((i & 15) == 0) std::this_thread::yield();  // let readers in
+            }
+            done = true;
+            for (auto& t : readers) t.join();
+
+            std::sort(lat.begin(), lat.end());
+            BusRunStats st;
+            st.p50_us = lat[lat.size() / 2];
+            st.p99_us = lat[lat.size() * 99 / 100];
+            st.max_us = lat.back();
+            st.reads = reads.load();
+            st.callbacks = callbacks.load();
+            st.ordered = ordered.load();
+            return st;
+        }
+
+        void PrintBusStats(const char* name, const BusRunStats& s) {
+            std::printf("  %-6s publish p50 %.3f us  p99 %.3f us  max %.1f us  Latest() reads %lld  callbacks %lld\n",
+                name, s.p50_us, s.p99_us, s.max_us, s.reads, s.callbacks);
+        }
+
+        // RCU bus vs the mutex baseline under reader contention.
+        bool RunTelemetryBus(const Options& opt) {
+            constexpr int kReaders = 3;
+            const int n_publish = std::max(1000, opt.iters * 50);
+
+            MutexTelemetryBus mutex_bus;
+            const BusRunStats ms = RunBus(mutex_bus, n_publish, kReaders);
+            PrintBusStats("mutex", ms);
+
+            core::telemetry::TelemetryBus bus;
+            const BusRunStats rs = RunBus(bus, n_publish, kReaders);
+            PrintBusStats("rcu", rs);
+
+            bool ok = rs.ordered && rs.callbacks == 2LL * n_publish;
+            ok = ok && bus.PublishCount() == static_cast<std::uint64_t>(n_publish);
+            ok = ok && bus.Latest() && bus.Latest()->t_ns == n_publish;
+            return ok;
+        }
+
+        // Publish loop as in the app (bus + subscriber keeping the last snapshot + a reader):
+        // the pool must serve everything without heap fallbacks. Then Acquire() vs make_shared.
+        bool RunSnapshotPool(const Options& opt) {
+            const int n_publish = std::max(1000, opt.iters * 50);
+
+            core::telemetry::TelemetrySnapshotPool pool(32);
+            core::telemetry::TelemetryBus bus;
+            SnapshotPtr held;  // a subscriber that keeps the last snapshot (like a recorder)
+            (void)bus.Subscribe([&held](SnapshotPtr s) { held = std::move(s); });
+
+            std::atomic<bool> done{ false };
+            std::thread reader([&] {
+                while (!done.load(std::memory_order_relaxed)) {
+                    const auto s = bus.Latest();
+                    std::this_thread::yield();
+                }
+            });
+            int max_in_use = 0;
+            for (int i = 0; i < n_publish; ++i) {
+                auto s = pool.Acquire();
+                s->t_ns = i + 1;
+                bus.Publish(std::move(s));
+                max_in_use = std::max(max_in_use, pool.stats().in_use);
+            }
+            done = true;
+            reader.join();
+
+            const auto st = pool.stats();
+            std::printf("  publish loop: acquired %llu  heap fallbacks %llu  max in use %d / %d\n",
+                static_cast<unsigned long long>(st.acquired), static_cast<unsigned long long>(st.heap_fallbacks),
+                max_in_use, st.capacity);
+            bool ok = st.heap_fallbacks == 0 && st.acquired == static_cast<std::uint64_t>(n_publish);
+
+            const int iters = opt.iters * 50;
+            const double t_heap = TimeUs(iters, [] {
+                auto s = std::make_shared<TelemetrySnapshot>();
+                s->t_ns = 1;
+            });
+            const double t_pool = TimeUs(iters, [&] {
+                auto s = pool.Acquire();
+                s->t_ns = 1;
+            });
+            std::printf("  make_shared %.3f us  pool Acquire %.3f us  (acquire + release, %zu-byte snapshot)\n",
+                t_heap, t_pool, sizeof(TelemetrySnapshot));
+
+            // Pool full -> heap, and the slots come back once released
+            const auto before = pool.stats();
+            std::vector<std::shared_ptr<TelemetrySnapshot>> hold;
+            for (int i = 0; i < before.capacity - before.in_use + 2; ++i) hold.push_back(pool.Acquire());
+            const auto full = pool.stats();
+            hold.clear();
+            const auto after = pool.stats();
+            ok = ok && full.heap_fallbacks == before.heap_fallbacks + 2 && full.in_use == full.capacity;
+            ok = ok && after.in_use == before.in_use;
+            return ok;
+        }
+
+        // Bus timeline under a concurrent cursor reader: every point read must be the next
+        // one (t_ns = index + 1) unless reported lost; small ring so wrap-around happens.
+        bool RunTelemetryTimeline(const Options& opt) {
+            constexpr int kCapacity = 256;
+            const int n_points = std::max(10000, opt.iters * 500);
+            core::telemetry::TelemetryBus bus(kCapacity);
+
+            std::atomic<bool> done{ false };
+            long long read_points = 0, lost = 0, bad = 0, calls = 0;
+            std::thread reader([&] {
+                std::vector<core::telemetry::TimelinePoint> buf(64);
+                std::uint64_t cursor = 0;
+                for (;;) {
+                    const bool last = done.load(std::memory_order_acquire);
+                    const auto r = bus.ReadTimelineSince(cursor, buf.data(), static_cast<int>(buf.size()));
+                    ++calls;
+                    lost += r.lost;
+                    for (int i = 0; i < r.points; ++i) {
+                        const std::uint64_t idx = r.next_cursor - static_cast<std::uint64_t>(r.points) + static_cast<std::uint64_t>(i);
+                        if (buf[static_cast<std::size_t>(i)].t_ns != static_cast<std::int64_t>(idx + 1)) ++bad;
+                    }
+                    read_points += r.points;
+                    cursor = r.next_cursor;
+                    if (last && r.points == 0) break;
+                    if (r.points == 0) std::this_thread::yield();
+                }
+            });
+
+            const double t0 = NowUs();
+            for (int i = 0; i < n_points; ++i) {
+                bus.AppendTimeline(core::telemetry::TimelinePoint{ i + 1, 0.5f });
+                if ((i & 63) == 0) std::this_thread::yield();
+            }
+            const double append_us = (NowUs() - t0) / n_points;
+            done.store(true, std::memory_order_release);
+            reader.join();
+
+            std::printf("  append %.3f us/point  read %lld + lost %lld of %d points in %lld calls, bad %lld\n",
+                append_us, read_points, lost, n_points, calls, bad);
+            return bad == 0 && read_points + lost == n_points;
+        }
+
+        // One slow subscriber (about 1 ms per callback, like a file logger) and a publisher
+        // at the audio chunk pace compressed 10x: publish latency sync vs async, and
+        // delivered + dropped + queued must account for every publish.
+        bool RunTelemetryAsync(const Options& opt) {
+            using Bus = core::telemetry::TelemetryBus;
+            const int n_publish = std::max(200, opt.iters);
+            const auto slow = [](SnapshotPtr) { std::this_thread::sleep_for(std::chrono::microseconds(1000)); };
+
+            struct Mode {
+                const char* name;
+                Bus::SubscribeOptions opt;
+            };
+            Bus::SubscribeOptions sync_opt;
+            Bus::SubscribeOptions drop_opt;
+            drop_opt.async = true;
+            drop_opt.queue_capacity = 8;
+            Bus::SubscribeOptions coalesce_opt = drop_opt;
+            coalesce_opt.overflow = Bus::OverflowPolicy::kCoalesce;
+            const Mode modes[] = { { "sync", sync_opt }, { "drop", drop_opt }, { "coalesce", coalesce_opt } };
+
+            bool ok = true;
+            for (const Mode& mode : modes) {
+                Bus bus;
+                const std::uint64_t id = bus.Subscribe(slow, mode.opt);
+
+                std::vector<double> lat(static_cast<std::size_t>(n_publish));
+                for (int i = 0; i < n_publish; ++i) {
+                    auto s = std::make_shared<TelemetrySnapshot>();
+                    s->t_ns = i + 1;
+                    const double t0 = NowUs();
+                    bus.Publish(std::move(s));
+                    lat[static_cast<std::size_t>(i)] = NowUs() - t0;
+                    std::this_thread::sleep_for(std::chrono::microseconds(200));
+                }
+
+                Bus::SubscriberStats st;
+                const double wait0 = NowUs();
+                while (bus.GetSubscriberStats(id, &st) && st.queued > 0 && NowUs() - wait0 < 2e6) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                std::sort(lat.begin(), lat.end());
+                std::printf("  %-8s publish p50 %.1f us  max %.1f us  delivered %llu  dropped %llu  max lag %d\n",
+                    mode.name, lat[lat.size() / 2], lat.back(),
+                    static_cast<unsigned long long>(st.delivered), static_cast<unsigned long long>(st.dropped), st.max_queued);
+
+                ok = ok && st.queued == 0 && st.delivered + st.dropped == static_cast<std::uint64_t>(n_publish);
+                if (mode.opt.async) ok = ok && st.max_queued <= mode.opt.queue_capacity && lat.back() < 1000.0;
+                bus.Unsubscribe(id);
+            }
+            return ok;
+        }
+
+        // Flight recorder: per-record cost (rotation included) and read-back of what survives
+        // rotation (max_files newest files, contents identical to what was recorded).
+        bool RunTelemetryRecorder(const Options& opt) {
+            using core::telemetry::TelemetryRecorder;
+            using core::telemetry::TelemetryRecordReader;
+
+            const std::uint64_t per_file = 16384;
+            const int max_files = 2;
+            const std::uint64_t n = std::max<std::uint64_t>(5 * per_file + 123, static_cast<std::uint64_t>(opt.iters));
+
+            TelemetryRecorder::Config cfg;
+            cfg.path_prefix = (std::filesystem::temp_directory_path() / "uav_bench_trec" / "rec").string();
+            cfg.records_per_file = per_file;
+            cfg.max_files = max_files;
+            TelemetryRecorder rec;
+            if (!rec.Open(cfg)) return false;
+
+            auto make = [](std::uint64_t i) {
+                TelemetrySnapshot s;
+                s.t_ns = static_cast<std::int64_t>(i) * 20'000'000;
+                s.p_detect_latest = static_cast<float>(i % 1000) / 1000.0f;
+                s.fsm_state = static_cast<core::telemetry::FsmState>(i % 4);
+                s.event_started = (i % 7) == 0;
+                s.tcn_used_for_latest = (i % 3) == 0;
+                return s;
+            };
+
+            double max_us = 0.0;
+            const double t0 = NowUs();
+            for (std::uint64_t i = 0; i < n; ++i) {
+                const TelemetrySnapshot s = make(i);
+                const double r0 = NowUs();
+                rec.Record(s);
+                max_us = std::max(max_us, NowUs() - r0);
+            }
+            const double per_us = (NowUs() - t0) / static_cast<double>(n);
+            const std::uint64_t last_file = rec.stats().files - 1;
+            rec.Close();
+
+            // Expect files last_file - max_files + 1 .. last_file, older ones deleted
+            bool ok = rec.stats().records == n && rec.stats().write_failures == 0;
+            std::uint64_t checked = 0;
+            for (std::uint64_t f = 0; f <= last_file; ++f) {
+                const std::string path = TelemetryRecorder::FileName(cfg.path_prefix, f);
+                const bool kept = f + static_cast<std::uint64_t>(max_files) > last_file;
+                if (!kept) {
+                    ok = ok && !std::filesystem::exists(path);
+                    continue;
+                }
+                TelemetryRecordReader reader;
+                if (!reader.Open(path)) return false;
+                ok = ok && reader.file_index() == f;
+                for (std::uint64_t i = 0; i < reader.count(); ++i) {
+                    TelemetrySnapshot got;
+                    core::telemetry::DecodeRecord(reader.records()[i], &got);
+                    const TelemetrySnapshot want = make(f * per_file + i);
+                    ok = ok && got.t_ns == want.t_ns && got.p_detect_latest == want.p_detect_latest &&
+                        got.fsm_state == want.fsm_state && got.event_started == want.event_started &&
+                        got.tcn_used_for_latest == want.tcn_used_for_latest;
+                    ++checked;
+                }
+            }
+            std::error_code ec;
+            std::filesystem::remove_all(std::filesystem::path(cfg.path_prefix).parent_path(), ec);
+
+            std::printf("  Record()        %.3f us / snapshot  max %.1f us (rotation)  %llu files\n",
+                per_us, max_us, static_cast<unsigned long long>(last_file + 1));
+            std::printf("  read back       %llu records from the %d newest files\n",
+                static_cast<unsigned long long>(checked), max_files);
+            return ok && checked == (n - (last_file + 1 - max_files) * per_file) && per_us < 1.0;
+        }
+
+        // LatencyHistogram: percentiles vs exact ones on a wide (log-normal) distribution,
+        // Record() cost, and no lost counts with concurrent writers.
+        bool RunLatencyHistogram(const Options& opt) {
+            using core::telemetry::LatencyHistogram;
+            const int n = std::max(200000, opt.iters);
+
+            std::mt19937_64 rng(7);
+            std::lognormal_distribution<double> dist(std::log(50'000.0), 1.5);  // ~50 us median
+            std::vector<std::int64_t> v(static_cast<std::size_t>(n));
+            for (auto& x : v) x = static_cast<std::int64_t>(dist(rng));
+
+            LatencyHistogram h;
+            const double t0 = NowUs();
+            for (std::int64_t x : v) h.Record(x);
+            const double ns_per = (NowUs() - t0) * 1e3 / static_cast<double>(n);
+
+            std::sort(v.begin(), v.end());
+            double worst = 0.0;
+            for (double q : { 0.5, 0.9, 0.99, 0.999 }) {
+                const std::size_t rank = static_cast<std::size_t>(std::ceil(q * static_cast<double>(n)));
+                const double exact = static_cast<double>(v[std::max<std::size_t>(rank, 1) - 1]);
+                const double got = static_cast<double>(h.Percentile(q));
+                const double rel = std::abs(got - exact) / exact;
+                worst = std::max(worst, rel);
+                std::printf("  p%-6g exact %10.1f us  histogram %10.1f us  (%.2f%%)\n",
+                    q * 100.0, exact * 1e-3, got * 1e-3, rel * 100.0);
+            }
+            const bool max_ok = h.max() == v.back();
+
+            // Concurrent writers: every Record() counted
+            LatencyHistogram hc;
+            const int threads = 4;
+            const int per_thread = 50000;
+            std::vector<std::thread> ws;
+            for (int t = 0; t < threads; ++t) {
+                ws.emplace_back([&hc, t] {
+                    for (int i = 0; i < per_thread; ++i) hc.Record((t + 1) * 1000 + i);
+                });
+            }
+            for (auto& w : ws) w.join();
+            const std::uint64_t buckets_total = hc.count();
+
+            std::printf("  Record()  %.1f ns   max error %.2f%% (bound %.2f%%)  concurrent count %llu/%d\n",
+                ns_per, worst * 100.0, 100.0 / LatencyHistogram::kSubBuckets,
+                static_cast<unsigned long long>(buckets_total), threads * per_thread);
+            return max_ok && worst <= 1.0 / LatencyHistogram::kSubBuckets &&
+                buckets_total == static_cast<std::uint64_t>(threads * per_thread) &&
+                hc.Percentile(1.0) == hc.max();
+        }
+
+    }  // namespace
+
+    std::vector<Case> TelemetryCases() {
+        return {
+            { "telemetry_bus", "TelemetryBus RCU vs mutex: publish latency with 3 Latest() readers, 2 subscribers", &RunTelemetryBus },
+            { "telemetry_timeline", "TelemetryBus timeline ring: cursor reads under concurrent appends (continuity, lost points)", &RunTelemetryTimeline },
+            { "telemetry_async", "TelemetryBus async subscribers: slow callback, publish latency, drop/coalesce accounting", &RunTelemetryAsync },
+            { "telemetry_recorder", "TelemetryRecorder: cost per snapshot with rotation, read-back after rotation", &RunTelemetryRecorder },
+            { "latency_histogram", "LatencyHistogram: percentile error vs exact, Record() cost, concurrent writers", &RunLatencyHistogram },
+            { "snapshot_pool", "TelemetrySnapshotPool: no heap fallbacks in the publish loop, Acquire vs make_shared", &RunSnapshotPool },
+        };
+    }
+
+}  // namespace bench
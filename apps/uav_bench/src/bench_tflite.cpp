@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+
+#include "core/tflite/tflite_runner.h"
+
+// Built only when core_tflite exists (UAV_ENABLE_TFLITE and TensorFlow Lite found).
+namespace bench {
+
+    namespace {
+
+        struct RunnerConfig {
+            const char* name;
+            core::ml::TfliteRunnerOptions opt;
+        };
+
+        core::ml::TfliteRunnerOptions Opt(int threads, bool xnnpack, bool fp16 = false, bool dynamic_range = false) {
+            core::ml::TfliteRunnerOptions o;
+            o.num_threads = threads;
+            o.xnnpack = xnnpack;
+            o.xnnpack_fp16 = fp16;
+            o.xnnpack_dynamic_range = dynamic_range;
+            o.log = false;
+            return o;
+        }
+
+        // Same model and input under each interpreter configuration: Invoke latency and
+        // output drift against the first (single-threaded, no explicit delegate) one.
+        // Works for float and fully quantized (int8/uint8) models alike.
+        // Model: $UAV_TFLITE_MODEL or ./model_dynamic.tflite; skipped if missing.
+        bool RunTfliteConfigs(const Options& opt) {
+            const char* env_model = std::getenv("UAV_TFLITE_MODEL");
+            const std::string model = (env_model && env_model[0]) ? env_model : "model_dynamic.tflite";
+            if (!std::filesystem::exists(model)) {
+                std::printf("  model %s not found (set UAV_TFLITE_MODEL), skipped\n", model.c_str());
+                return true;
+            }
+
+            const int hw = std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, 4);
+            const RunnerConfig configs[] = {
+                { "1 thread", Opt(1, false) },
+                { "N threads", Opt(hw, false) },
+                { "xnnpack 1t", Opt(1, true) },
+                { "xnnpack Nt", Opt(hw, true) },
+                { "xnnpack fp16", Opt(hw, true, true) },
+                { "xnnpack dynrange", Opt(hw, true, false, true) },
+            };
+            const int iters = std::clamp(opt.iters, 5, 50);
+
+            std::vector<float> input;
+            std::vector<float> reference;
+            bool ok = true;
+            std::printf("  %-17s %7s %5s %10s %10s %12s\n", "config", "threads", "plan", "p50_ms", "max_ms", "max |diff|");
+            for (const RunnerConfig& c : configs) {
+                core::ml::TfliteRunner runner(model, c.opt);
+                if (!runner.IsValid()) {
+                    std::printf("  %-17s runner invalid\n", c.name);
+                    ok = false;
+                    continue;
+                }
+                if (input.empty()) {
+                    std::mt19937 rng(3);
+                    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+                    input.resize(static_cast<std::size_t>(runner.input_size()));
+                    for (float& x : input) x = dist(rng);
+                }
+                runner.SetInput(input);  // float32 copy or int8/uint8 quantization
+
+                for (int i = 0; i < 3; ++i) runner.Invoke();  // warm-up (delegate setup, caches)
+                std::vector<double> ms(static_cast<std::size_t>(iters));
+                for (int i = 0; i < iters; ++i) {
+                    const double t0 = NowUs();
+                    runner.Invoke();
+                    ms[static_cast<std::size_t>(i)] = (NowUs() - t0) * 1e-3;
+                }
+                std::sort(ms.begin(), ms.end());
+
+                const std::span<const float> out = runner.output_span();
+                if (reference.empty()) reference.assign(out.begin(), out.end());
+                double diff = 0.0;
+                double scale = 1.0;
+                for (std::size_t i = 0; i < out.size() && i < reference.size(); ++i) {
+                    diff = std::max(diff, static_cast<double>(std::abs(out[i] - reference[i])));
+                    scale = std::max(scale, static_cast<double>(std::abs(reference[i])));
+                }
+
+                const auto& a = runner.applied();
+                char name[64];
+                std::snprintf(name, sizeof(name), "%s%s%s%s", c.name, (c.opt.xnnpack && !a.xnnpack) ? " (no xnnpack)" : "",
+                    (c.opt.xnnpack_fp16 && !a.xnnpack_fp16) ? " (no fp16)" : "",
+                    (c.opt.xnnpack_dynamic_range && !a.xnnpack_dynamic_range) ? " (no dynrange)" : "");
+                std::printf("  %-17s %7d %2d/%-2d %10.3f %10.3f %12.2e\n", name, a.num_threads, a.delegate_nodes, a.plan_nodes,
+                    ms[ms.size() / 2], ms.back(), diff);
+
+                // fp16 / dynamic range change the arithmetic: allow a few percent of the output scale
+                ok = ok && diff <= 0.05 * scale;
+            }
+            return ok;
+        }
+
+    }  // namespace
+
+    std::vector<Case> TfliteCases() {
+        return {
+            { "tflite_configs", "TfliteRunner: Invoke latency per thread count / XNNPACK mode, output drift", &RunTfliteConfigs },
+        };
+    }
+
+}  // namespace bench
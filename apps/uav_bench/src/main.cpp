@@ -0,0 +1,63 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+
+static std::optional<std::string> GetArgValue(int argc, char* argv[], const std::string& key) {
+    const std::string prefix = key + "=";
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.rfind(prefix, 0) == 0) {
+            return arg.substr(prefix.size());
+        }
+    }
+    return std::nullopt;
+}
+
+static std::vector<bench::Case> AllCases() {
+    std::vector<bench::Case> all;
+    for (const auto& c : bench::DspCases()) all.push_back(c);
+    for (const auto& c : bench::RingCases()) all.push_back(c);
+    for (const auto& c : bench::TelemetryCases()) all.push_back(c);
+    for (const auto& c : bench::DetectCases()) all.push_back(c);
+#if UAV_BENCH_HAVE_TFLITE
+    for (const auto& c : bench::TfliteCases()) all.push_back(c);
+#endif
+    return all;
+}
+
+// uav_bench [--case=<name>|all] [--iters=N]
+// Exit code is non-zero if any selected case fails its accuracy check.
+int main(int argc, char* argv[]) {
+    const auto arg_case = GetArgValue(argc, argv, "--case");
+    const auto arg_iters = GetArgValue(argc, argv, "--iters");
+
+    bench::Options opt;
+    if (arg_iters) opt.iters = std::max(1, std::atoi(arg_iters->c_str()));
+
+    const std::string which = arg_case ? *arg_case : "all";
+    const auto cases = AllCases();
+
+    bool ok = true;
+    int ran = 0;
+    for (const auto& c : cases) {
+        if (which != "all" && which != c.name) continue;
+        std::cout << "== " << c.name << " ==\n";
+        const bool case_ok = c.run(opt);
+        std::cout << (case_ok ? "[OK] " : "[FAIL] ") << c.name << "\n\n";
+        ok = ok && case_ok;
+        ++ran;
+    }
+
+    if (ran == 0) {
+        std::cerr << "[bench] unknown case: " << which << "\n";
+        std::cerr << "cases:\n";
+        for (const auto& c : cases) std::cerr << "  " << c.name << "  - " << c.help << "\n";
+        return 2;
+    }
+    return ok ? 0 : 1;
+}
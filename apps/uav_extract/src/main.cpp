@@ -0,0 +1,256 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/audio/sndfile_replay_source.h"
+#include "core/dsp/i_pcen_frame_sink.h"
+#include "core/dsp/pcen_presets.h"
+#include "core/io/mapped_file.h"
+
+// Offline PCEN extraction for training sets.
+//
+//   uav_extract --list=<files.txt> --out=<features.f32> [--index=<features.csv>]
+//               [--threads=N] [--chunk_ms=200]
+//
+// Every file in the list (one path per line, '#' comments) is decoded with
+// SndfileReplaySource (non-realtime, no loop), downmixed to mono and run through the
+// production PCEN pipeline (core/dsp/pcen_presets.h, same features as the live GUI).
+// Files are processed on a worker pool with one extractor per thread.
+//
+// Output: one memory-mapped float32 tensor [total_frames][n_mels]; each file owns a
+// contiguous row range, written in place by its worker. The index CSV maps files to rows.
+
+static std::optional<std::string> GetArgValue(int argc, char* argv[], const std::string& key) {
+    const std::string prefix = key + "=";
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.rfind(prefix, 0) == 0) {
+            return arg.substr(prefix.size());
+        }
+    }
+    return std::nullopt;
+}
+
+namespace {
+
+    struct Job {
+        std::string path;
+        int sample_rate = 0;
+        int channels = 0;
+        std::int64_t samples = 0;        // per channel
+        std::int64_t row_offset = 0;     // first output frame
+        std::int64_t rows_reserved = 0;  // frames expected from the file length
+        std::int64_t rows = 0;           // frames actually written
+        std::string status = "pending";
+    };
+
+    std::vector<std::string> ReadList(const std::string& list_path) {
+        std::vector<std::string> out;
+        std::ifstream in(list_path);
+        std::string line;
+        while (std::getline(in, line)) {
+            while (!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t')) line.pop_back();
+            if (line.empty() || line[0] == '#') continue;
+            out.push_back(line);
+        }
+        return out;
+    }
+
+    std::string CsvQuote(const std::string& s) {
+        std::string q = "\"";
+        for (char c : s) {
+            if (c == '"') q += '"';
+            q += c;
+        }
+        q += '"';
+        return q;
+    }
+
+    // Frames PcenExtractor emits for n samples
+    std::int64_t FramesFor(std::int64_t n, int win, int hop) {
+        return (n >= win) ? 1 + (n - win) / hop : 0;
+    }
+
+    void RunJob(Job& job, core::dsp::ProductionPcenExtractor& pcen, int chunk_ms, float* rows_base,
+        std::vector<float>& mono) {
+        core::audio::AudioSourceConfig acfg;
+        acfg.sample_rate = job.sample_rate;
+        acfg.channels = job.channels;
+        acfg.chunk_ms = chunk_ms;
+        acfg.realtime = false;
+        acfg.loop = false;
+
+        core::audio::SndfileReplaySource src(job.path);
+        if (!src.Open(acfg)) {
+            job.status = "open_failed";
+            return;
+        }
+
+        constexpr int mels = core::dsp::ProductionPcenExtractor::n_mels();
+        core::dsp::SpanFrameSink sink(rows_base + job.row_offset * mels, static_cast<int>(job.rows_reserved), mels);
+        pcen.Reset();
+
+        while (auto chunk = src.Read()) {
+            const int frames = chunk->frames;
+            const int ch = chunk->channels;
+            const float* inter = chunk->interleaved.data();
+
+            mono.resize(static_cast<std::size_t>(frames));
+            if (ch == 1) {
+                std::copy(inter, inter + frames, mono.begin());
+            }
+            else {
+                for (int i = 0; i < frames; ++i) {
+                    float s = 0.0f;
+                    for (int c = 0; c < ch; ++c) s += inter[i * ch + c];
+                    mono[static_cast<std::size_t>(i)] = s / static_cast<float>(ch);
+                }
+            }
+            pcen.Process(mono.data(), frames, &sink);
+        }
+
+        job.rows = sink.frames();
+        // Length from the header and decoded length can disagree (damaged files):
+        // unwritten reserved rows stay zero and are not listed in the index.
+        job.status = (job.rows == job.rows_reserved) ? "ok" : "short";
+    }
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    const auto arg_list = GetArgValue(argc, argv, "--list");
+    const auto arg_out = GetArgValue(argc, argv, "--out");
+    const auto arg_index = GetArgValue(argc, argv, "--index");
+    const auto arg_threads = GetArgValue(argc, argv, "--threads");
+    const auto arg_chunk = GetArgValue(argc, argv, "--chunk_ms");
+
+    if (!arg_list || !arg_out) {
+        std::cerr << "usage: uav_extract --list=<files.txt> --out=<features.f32> [--index=<features.csv>]"
+            " [--threads=N] [--chunk_ms=200]\n";
+        return 2;
+    }
+
+    const std::string out_path = *arg_out;
+    const std::string index_path = arg_index.value_or(out_path + ".csv");
+    const int chunk_ms = std::max(10, arg_chunk ? std::atoi(arg_chunk->c_str()) : 200);
+    int threads = arg_threads ? std::atoi(arg_threads->c_str())
+        : static_cast<int>(std::thread::hardware_concurrency());
+    threads = std::max(1, threads);
+
+    const core::dsp::PcenConfig pcfg = core::dsp::ProductionPcenConfig();
+    constexpr int mels = core::dsp::ProductionPcenExtractor::n_mels();
+
+    // --- probe: lengths -> row ranges ---
+    std::vector<Job> jobs;
+    for (auto& path : ReadList(*arg_list)) {
+        Job job;
+        job.path = std::move(path);
+
+        core::audio::AudioSourceConfig acfg;
+        acfg.realtime = false;
+        acfg.loop = false;
+        core::audio::SndfileReplaySource probe(job.path);
+        if (!probe.Open(acfg)) {
+            job.status = "open_failed";
+        }
+        else {
+            job.sample_rate = probe.file_sample_rate();
+            job.channels = probe.file_channels();
+            job.samples = probe.file_frames();
+            if (job.sample_rate != pcfg.sample_rate) {
+                // no resampler in the pipeline: features would not match the live ones
+                job.status = "sample_rate_mismatch";
+            }
+            else {
+                job.rows_reserved = FramesFor(job.samples, pcfg.win_length, pcfg.hop_length);
+            }
+        }
+        jobs.push_back(std::move(job));
+    }
+    if (jobs.empty()) {
+        std::cerr << "[uav_extract] no input files in " << *arg_list << "\n";
+        return 1;
+    }
+
+    std::int64_t total_rows = 0;
+    for (auto& job : jobs) {
+        job.row_offset = total_rows;
+        total_rows += job.rows_reserved;
+    }
+
+    core::io::MappedFile out;
+    const std::size_t bytes = static_cast<std::size_t>(total_rows) * mels * sizeof(float);
+    if (!out.Create(out_path, bytes)) {
+        std::cerr << "[uav_extract] cannot create " << out_path << " (" << bytes << " bytes)\n";
+        return 1;
+    }
+    float* rows_base = reinterpret_cast<float*>(out.data());
+
+    std::cout << "[uav_extract] " << jobs.size() << " files, " << total_rows << " frames x " << mels
+        << " mels, " << threads << " threads\n";
+
+    // --- worker pool: each thread owns one extractor and takes the next file ---
+    std::atomic<std::size_t> next{ 0 };
+    std::mutex log_mu;
+    const auto t0 = std::chrono::steady_clock::now();
+
+    auto worker = [&] {
+        core::dsp::ProductionPcenExtractor pcen(core::dsp::ParamsOf(pcfg));
+        std::vector<float> mono;
+        for (;;) {
+            const std::size_t i = next.fetch_add(1);
+            if (i >= jobs.size()) break;
+            Job& job = jobs[i];
+            if (job.status != "pending") continue;
+
+            RunJob(job, pcen, chunk_ms, rows_base, mono);
+
+            std::lock_guard<std::mutex> lk(log_mu);
+            std::cout << "[" << (i + 1) << "/" << jobs.size() << "] " << job.status << " " << job.rows
+                << " frames  " << job.path << "\n";
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) pool.emplace_back(worker);
+    for (auto& th : pool) th.join();
+
+    const double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    out.Flush();
+    out.Close();
+
+    // --- index ---
+    std::ofstream idx(index_path);
+    if (!idx) {
+        std::cerr << "[uav_extract] cannot write index " << index_path << "\n";
+        return 1;
+    }
+    idx << "# tensor=" << out_path << " dtype=float32 layout=[frame][mel] n_mels=" << mels
+        << " sample_rate=" << pcfg.sample_rate << " n_fft=" << pcfg.n_fft << " hop_length=" << pcfg.hop_length
+        << " total_frames=" << total_rows << "\n";
+    idx << "path,status,sample_rate,channels,samples,row_offset,rows\n";
+
+    int failed = 0;
+    double audio_s = 0.0;
+    for (const auto& job : jobs) {
+        idx << CsvQuote(job.path) << "," << job.status << "," << job.sample_rate << "," << job.channels << ","
+            << job.samples << "," << job.row_offset << "," << job.rows << "\n";
+        if (job.status != "ok") ++failed;
+        if (job.sample_rate > 0 && job.rows > 0) audio_s += static_cast<double>(job.samples) / job.sample_rate;
+    }
+
+    std::cout << "[uav_extract] done: " << (jobs.size() - static_cast<std::size_t>(failed)) << " ok, " << failed
+        << " failed, " << audio_s << " s of audio in " << wall_s << " s (x" << (wall_s > 0.0 ? audio_s / wall_s : 0.0)
+        << " realtime)\n";
+    std::cout << "[uav_extract] tensor: " << out_path << "  index: " << index_path << "\n";
+    return failed == 0 ? 0 : 1;
+}
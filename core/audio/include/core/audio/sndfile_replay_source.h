@@ -20,6 +20,8 @@ namespace core::audio {
 
 		int file_sample_rate() const { return file_sr_; }
 		int file_channels() const { return file_ch_; }
+		// Length of the file in frames (samples per channel), 0 if unknown
+		std::int64_t file_frames() const { return file_frames_; }
 
 	private:
 		std::int64_t now_ns() const;
@@ -31,6 +33,7 @@ namespace core::audio {
 		void* snd_{ nullptr };
 		int file_sr_{ 0 };
 		int file_ch_{ 0 };
+		std::int64_t file_frames_{ 0 };
 
 		std::vector<float> buf_;
 		std::int64_t t0_ns_{ 0 };
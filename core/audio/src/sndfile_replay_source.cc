@@ -28,6 +28,7 @@ namespace core::audio {
         (void)cfg_;
         file_sr_ = 0;
         file_ch_ = 0;
+        file_frames_ = 0;
         return false;
 #else
 
@@ -38,6 +39,7 @@ namespace core::audio {
         snd_ = f;
         file_sr_ = sfinfo.samplerate;
         file_ch_ = sfinfo.channels;
+        file_frames_ = static_cast<std::int64_t>(sfinfo.frames);
 
         // Принимаем фактические параметры файла.
         // Downmix/resample делаем вне источника (в main), чтобы быстрее получить MVP.
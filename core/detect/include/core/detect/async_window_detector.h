@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "core/detect/i_window_model.h"
+#include "core/dsp/pcen_ring_buffer.h"
+
+namespace core::detect {
+
+    /**
+     * @brief Runs an IWindowModel on its own thread, off the audio path.
+     *
+     * - Post(end_seq): the audio thread announces the newest PCEN window (frames
+     *   [end_seq - n_frames, end_seq) of the ring). Single-slot mailbox: one atomic store
+     *   plus a wake-up, never waits. A window not yet picked up is replaced (stale windows
+     *   are dropped, never queued).
+     * - The worker copies the window from the ring straight into model->input_buffer()
+     *   (PcenRingBuffer::CopyRange, lock-free) and runs Infer().
+     * - Streaming models (IWindowModel::step_frames() > 0) only get the frames that arrived
+     *   since the last window, one step per Infer(). When the worker is more than a
+     *   receptive field (n_frames) behind, or frames were overwritten, it resets the model
+     *   state and re-primes from the newest n_frames frames instead of catching up.
+     * - Results go through a triple buffer: TakeLatest() returns the newest one, with the
+     *   sequence number and timestamp of the window it came from.
+     *
+     * Single producer (Post) and single consumer (TakeLatest), normally the same thread.
+     */
+    class AsyncWindowDetector {
+    public:
+        struct Result {
+            float p_detect = 0.0f;
+            std::uint64_t window_end_seq = 0;  // window = frames [end - n_frames, end)
+            std::int64_t window_t_ns = 0;      // time of the window's newest frame
+            std::int64_t infer_ns = 0;         // Infer() duration
+        };
+
+        struct Stats {
+            std::uint64_t posted = 0;    // windows posted
+            std::uint64_t inferred = 0;  // results produced
+            std::uint64_t dropped = 0;   // replaced in the mailbox before the worker got to them
+            std::uint64_t skipped = 0;   // not readable any more (overwritten) or not enough frames yet
+            std::uint64_t failed = 0;    // Infer() returned false
+            std::uint64_t steps = 0;     // streaming model: Infer() calls (one per step)
+            std::uint64_t resets = 0;    // streaming model: state resets (first window, fell behind)
+        };
+
+        // model is not owned and must outlive the detector
+        AsyncWindowDetector(std::shared_ptr<const core::dsp::PcenRingBuffer> ring, IWindowModel* model);
+        ~AsyncWindowDetector();
+
+        AsyncWindowDetector(const AsyncWindowDetector&) = delete;
+        AsyncWindowDetector& operator=(const AsyncWindowDetector&) = delete;
+
+        // false if the model does not fit the ring (n_mels, capacity)
+        bool Start();
+        // Call after the last Post()
+        void Stop();
+
+        void Post(std::uint64_t end_seq);
+        bool TakeLatest(Result* out);
+
+        Stats stats() const;
+
+    private:
+        void Run();
+        void Process(std::uint64_t end_seq);
+        void ProcessStream(std::uint64_t end_seq);
+
+        // mailbox_ value that tells the worker to exit
+        static constexpr std::uint64_t kStopSeq = ~std::uint64_t{ 0 };
+        static constexpr int kDirty = 4;  // middle_ holds an untaken result
+
+        std::shared_ptr<const core::dsp::PcenRingBuffer> ring_;
+        IWindowModel* model_ = nullptr;
+        std::vector<std::int64_t> t_scratch_;  // frame times of the window (worker)
+        int step_frames_ = 0;                  // model_->step_frames(), 0: window model
+
+        // Streaming model position (worker): next frame to feed, valid when primed
+        std::uint64_t stream_next_ = 0;
+        bool stream_primed_ = false;
+
+        alignas(64) std::atomic<std::uint64_t> mailbox_{ 0 };  // end_seq of the newest window, 0: none
+        std::atomic<bool> stop_{ false };
+        std::thread worker_;
+
+        // Triple buffer: back_ is the worker's, front_ the reader's, middle_ is swapped
+        Result results_[3];
+        int back_ = 0;
+        int front_ = 1;
+        alignas(64) std::atomic<int> middle_{ 2 };
+
+        std::uint64_t last_posted_ = 0;  // producer side
+        std::atomic<std::uint64_t> posted_{ 0 };
+        std::atomic<std::uint64_t> taken_{ 0 };
+        std::atomic<std::uint64_t> inferred_{ 0 };
+        std::atomic<std::uint64_t> skipped_{ 0 };
+        std::atomic<std::uint64_t> failed_{ 0 };
+        std::atomic<std::uint64_t> steps_{ 0 };
+        std::atomic<std::uint64_t> resets_{ 0 };
+    };
+
+}  // namespace core::detect
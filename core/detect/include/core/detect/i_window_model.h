@@ -0,0 +1,32 @@
+#pragma once
+
+namespace core::detect {
+
+	// Model that scores a whole PCEN window ([n_frames][n_mels] floats, oldest frame first).
+	// The caller writes the window straight into input_buffer(), then calls Infer().
+	// Used from one thread at a time (AsyncWindowDetector's worker).
+	//
+	// Streaming models (step_frames() > 0) carry state between calls instead: each Infer()
+	// consumes the next step_frames() frames written to input_buffer(), in sequence order,
+	// and scores the n_frames() frames seen up to there (the receptive field). After
+	// ResetState() they behave as if every earlier frame was zero.
+	class IWindowModel {
+	public:
+		virtual ~IWindowModel() = default;
+
+		virtual int n_mels() const = 0;
+		virtual int n_frames() const = 0;
+
+		// Room for n_frames * n_mels floats (step_frames * n_mels when streaming);
+		// stays valid while the model lives
+		virtual float* input_buffer() = 0;
+
+		// Scores the window in input_buffer(): p_detect in [0..1]. false on error.
+		virtual bool Infer(float* p_detect) = 0;
+
+		// 0: window model. > 0: streaming model, frames consumed per Infer()
+		virtual int step_frames() const { return 0; }
+		virtual void ResetState() {}
+	};
+
+}  // namespace core::detect
@@ -0,0 +1,176 @@
+#include "core/detect/async_window_detector.h"
+
+#include <chrono>
+#include <iostream>
+#include <utility>
+
+namespace core::detect {
+
+    AsyncWindowDetector::AsyncWindowDetector(std::shared_ptr<const core::dsp::PcenRingBuffer> ring, IWindowModel* model)
+        : ring_(std::move(ring)), model_(model) {}
+
+    AsyncWindowDetector::~AsyncWindowDetector() { Stop(); }
+
+    bool AsyncWindowDetector::Start() {
+        if (worker_.joinable()) return true;
+        if (!ring_ || !model_ || !model_->input_buffer()) {
+            std::cerr << "[AsyncWindowDetector] no ring or model\n";
+            return false;
+        }
+        if (model_->n_mels() != ring_->n_mels() || model_->n_frames() <= 0 ||
+            model_->n_frames() > ring_->capacity_frames()) {
+            std::cerr << "[AsyncWindowDetector] model window " << model_->n_frames() << "x" << model_->n_mels()
+                << " does not fit ring " << ring_->capacity_frames() << "x" << ring_->n_mels() << "\n";
+            return false;
+        }
+        step_frames_ = model_->step_frames();
+        if (step_frames_ < 0 || step_frames_ > model_->n_frames()) {
+            std::cerr << "[AsyncWindowDetector] streaming step " << step_frames_ << " outside 1.."
+                << model_->n_frames() << "\n";
+            return false;
+        }
+
+        t_scratch_.assign(static_cast<std::size_t>(model_->n_frames()), 0);
+        stop_.store(false, std::memory_order_relaxed);
+        mailbox_.store(0, std::memory_order_relaxed);
+        last_posted_ = 0;
+        stream_primed_ = false;
+        worker_ = std::thread([this] { Run(); });
+        return true;
+    }
+
+    void AsyncWindowDetector::Stop() {
+        if (!worker_.joinable()) return;
+        stop_.store(true, std::memory_order_release);
+        mailbox_.store(kStopSeq, std::memory_order_release);
+        mailbox_.notify_one();
+        worker_.join();
+    }
+
+    void AsyncWindowDetector::Post(std::uint64_t end_seq) {
+        if (end_seq == 0 || end_seq == last_posted_) return;  // nothing new
+        last_posted_ = end_seq;
+        posted_.fetch_add(1, std::memory_order_relaxed);
+        mailbox_.store(end_seq, std::memory_order_release);
+        mailbox_.notify_one();
+    }
+
+    bool AsyncWindowDetector::TakeLatest(Result* out) {
+        if ((middle_.load(std::memory_order_relaxed) & kDirty) == 0) return false;
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & ~kDirty;
+        if (out) *out = results_[front_];
+        return true;
+    }
+
+    AsyncWindowDetector::Stats AsyncWindowDetector::stats() const {
+        Stats s;
+        s.posted = posted_.load(std::memory_order_relaxed);
+        s.inferred = inferred_.load(std::memory_order_relaxed);
+        s.skipped = skipped_.load(std::memory_order_relaxed);
+        s.failed = failed_.load(std::memory_order_relaxed);
+        s.steps = steps_.load(std::memory_order_relaxed);
+        s.resets = resets_.load(std::memory_order_relaxed);
+        const std::uint64_t taken = taken_.load(std::memory_order_relaxed);
+        s.dropped = s.posted > taken ? s.posted - taken : 0;  // includes one still in the mailbox
+        return s;
+    }
+
+    void AsyncWindowDetector::Run() {
+        std::uint64_t seen = 0;
+        for (;;) {
+            mailbox_.wait(seen, std::memory_order_acquire);
+            if (stop_.load(std::memory_order_acquire)) break;
+
+            const std::uint64_t end_seq = mailbox_.load(std::memory_order_acquire);
+            if (end_seq == seen) continue;
+            seen = end_seq;
+            taken_.fetch_add(1, std::memory_order_relaxed);
+            Process(end_seq);
+        }
+    }
+
+    void AsyncWindowDetector::Process(std::uint64_t end_seq) {
+        if (step_frames_ > 0) {
+            ProcessStream(end_seq);
+            return;
+        }
+
+        const int n_frames = model_->n_frames();
+        if (end_seq < static_cast<std::uint64_t>(n_frames)) {
+            skipped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        const core::dsp::PcenRangeCopy got = ring_->CopyRange(end_seq - static_cast<std::uint64_t>(n_frames), end_seq,
+            model_->input_buffer(), n_frames, t_scratch_.data());
+        if (got.frames != n_frames) {
+            skipped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        Result& r = results_[back_];
+        const auto t0 = std::chrono::steady_clock::now();
+        const bool ok = model_->Infer(&r.p_detect);
+        r.infer_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+        if (!ok) {
+            failed_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        r.window_end_seq = end_seq;
+        r.window_t_ns = t_scratch_[static_cast<std::size_t>(n_frames - 1)];
+
+        back_ = middle_.exchange(back_ | kDirty, std::memory_order_acq_rel) & ~kDirty;
+        inferred_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void AsyncWindowDetector::ProcessStream(std::uint64_t end_seq) {
+        const std::uint64_t step = static_cast<std::uint64_t>(step_frames_);
+        // Priming covers the receptive field in whole steps and ends at end_seq
+        const std::uint64_t prime = (static_cast<std::uint64_t>(model_->n_frames()) + step - 1) / step * step;
+        if (end_seq < prime) {
+            skipped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        // Catching up on more than a receptive field costs more than re-priming, and the
+        // output only depends on the last n_frames frames either way
+        if (!stream_primed_ || stream_next_ + prime < end_seq || stream_next_ > end_seq) {
+            model_->ResetState();
+            resets_.fetch_add(1, std::memory_order_relaxed);
+            stream_next_ = end_seq - prime;
+            stream_primed_ = true;
+        }
+
+        Result& r = results_[back_];
+        const auto t0 = std::chrono::steady_clock::now();
+        bool fed = false;
+        while (stream_next_ + step <= end_seq) {
+            const core::dsp::PcenRangeCopy got = ring_->CopyRange(stream_next_, stream_next_ + step,
+                model_->input_buffer(), step_frames_, t_scratch_.data());
+            if (got.frames != step_frames_ || got.first_seq != stream_next_) {  // overwritten meanwhile
+                stream_primed_ = false;
+                skipped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            steps_.fetch_add(1, std::memory_order_relaxed);
+            if (!model_->Infer(&r.p_detect)) {
+                stream_primed_ = false;  // state is unknown now
+                failed_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            stream_next_ += step;
+            fed = true;
+        }
+        if (!fed) {  // less than one step of new frames; they stay for the next window
+            skipped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        r.infer_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+        r.window_end_seq = stream_next_;
+        r.window_t_ns = t_scratch_[static_cast<std::size_t>(step_frames_ - 1)];
+
+        back_ = middle_.exchange(back_ | kDirty, std::memory_order_acq_rel) & ~kDirty;
+        inferred_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+}  // namespace core::detect
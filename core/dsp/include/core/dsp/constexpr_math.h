@@ -0,0 +1,117 @@
+#pragma once
+
+#include <numbers>
+
+namespace core::dsp::cx {
+
+    // Minimal constexpr math for compile-time tables (<cmath> is not constexpr in C++20).
+    // Evaluated in double; results rounded to float agree with the runtime float
+    // functions to the last bit for the table inputs we use.
+
+    constexpr double Abs(double x) { return x < 0.0 ? -x : x; }
+
+    // floor for |x| < 2^62
+    constexpr double Floor(double x) {
+        const double t = static_cast<double>(static_cast<long long>(x));
+        return (t > x) ? t - 1.0 : t;
+    }
+
+    namespace detail {
+
+        // Taylor series on |r| <= pi/4 (terms until they vanish)
+        constexpr double SinPoly(double r) {
+            const double r2 = r * r;
+            double term = r;
+            double sum = r;
+            for (int k = 1; k < 30; ++k) {
+                term *= -r2 / static_cast<double>((2 * k) * (2 * k + 1));
+                sum += term;
+                if (Abs(term) < 1e-20) break;
+            }
+            return sum;
+        }
+
+        constexpr double CosPoly(double r) {
+            const double r2 = r * r;
+            double term = 1.0;
+            double sum = 1.0;
+            for (int k = 1; k < 30; ++k) {
+                term *= -r2 / static_cast<double>((2 * k - 1) * (2 * k));
+                sum += term;
+                if (Abs(term) < 1e-20) break;
+            }
+            return sum;
+        }
+
+        // x = q*(pi/2) + r; pi/2 split in two parts (Cody-Waite) so r keeps full precision
+        constexpr double ReduceHalfPi(double x, int* quadrant) {
+            constexpr double kHalfPiHi = 1.5707963267948966;
+            constexpr double kHalfPiLo = 6.123233995736766e-17;
+            const double q = Floor(x / kHalfPiHi + 0.5);
+            *quadrant = static_cast<int>(static_cast<long long>(q) & 3);
+            return (x - q * kHalfPiHi) - q * kHalfPiLo;
+        }
+
+    }  // namespace detail
+
+    constexpr double Sin(double x) {
+        int q = 0;
+        const double r = detail::ReduceHalfPi(x, &q);
+        switch (q) {
+        case 0: return detail::SinPoly(r);
+        case 1: return detail::CosPoly(r);
+        case 2: return -detail::SinPoly(r);
+        default: return -detail::CosPoly(r);
+        }
+    }
+
+    constexpr double Cos(double x) {
+        int q = 0;
+        const double r = detail::ReduceHalfPi(x, &q);
+        switch (q) {
+        case 0: return detail::CosPoly(r);
+        case 1: return -detail::SinPoly(r);
+        case 2: return -detail::CosPoly(r);
+        default: return detail::SinPoly(r);
+        }
+    }
+
+    // e^x: x = k*ln2 + r, |r| <= ln2/2, Taylor series for e^r, then scale by 2^k
+    constexpr double Exp(double x) {
+        const double kf = Floor(x / std::numbers::ln2 + 0.5);
+        const double r = x - kf * std::numbers::ln2;
+        double term = 1.0;
+        double sum = 1.0;
+        for (int n = 1; n < 40; ++n) {
+            term *= r / static_cast<double>(n);
+            sum += term;
+            if (Abs(term) < 1e-18) break;
+        }
+        int k = static_cast<int>(kf);
+        for (; k > 0; --k) sum *= 2.0;
+        for (; k < 0; ++k) sum *= 0.5;
+        return sum;
+    }
+
+    // ln(x), x > 0: x = m * 2^e with m in [1/sqrt2, sqrt2), ln(m) = 2*atanh((m-1)/(m+1))
+    constexpr double Log(double x) {
+        if (x <= 0.0) return -1e308;
+        int e = 0;
+        while (x >= std::numbers::sqrt2) { x *= 0.5; ++e; }
+        while (x < std::numbers::sqrt2 * 0.5) { x *= 2.0; --e; }
+        const double t = (x - 1.0) / (x + 1.0);
+        const double t2 = t * t;
+        double term = t;
+        double sum = t;
+        for (int n = 3; n < 200; n += 2) {
+            term *= t2;
+            sum += term / static_cast<double>(n);
+            if (Abs(term) < 1e-18) break;
+        }
+        return 2.0 * sum + static_cast<double>(e) * std::numbers::ln2;
+    }
+
+    constexpr double Log10(double x) { return Log(x) / std::numbers::ln10; }
+    constexpr double Pow10(double x) { return Exp(x * std::numbers::ln10); }
+
+}  // namespace core::dsp::cx
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+
+namespace core::dsp {
+
+    enum class SimdIsa : int {
+        kScalar = 0,
+        kSse2 = 1,
+        kAvx2 = 2,   // AVX2 + FMA
+        kNeon = 3,
+    };
+
+    const char* SimdIsaName(SimdIsa isa);
+
+    // Butterfly passes over interleaved complex float data (re, im, re, im, ...),
+    // already in bit-reversed order. Twiddle tables use the FftPlan per-stage layout.
+    struct FftKernels {
+        SimdIsa isa = SimdIsa::kScalar;
+
+        // One radix-2 stage with half-size h over n points; w = that stage's h twiddles.
+        void (*radix2)(float* a, std::size_t n, std::size_t h, const float* w) = nullptr;
+
+        // Two fused radix-2 stages (half-sizes h and 2h) = one radix-4 pass.
+        // w1 = stage-h twiddles, w2 = stage-2h twiddles (only the first h are read).
+        void (*radix4)(float* a, std::size_t n, std::size_t h, const float* w1, const float* w2) = nullptr;
+    };
+
+    // Kernel set for `isa`, or nullptr when it is not built for this target or the
+    // running CPU does not support it.
+    const FftKernels* GetFftKernels(SimdIsa isa);
+
+    // Best kernel set for the running CPU, selected once on first use.
+    // UAV_FFT_ISA=scalar|sse2|avx2|neon overrides the choice (ignored if unsupported).
+    const FftKernels& ActiveFftKernels();
+
+    namespace detail {
+        void ScalarRadix2(float* a, std::size_t n, std::size_t h, const float* w);
+        void ScalarRadix4(float* a, std::size_t n, std::size_t h, const float* w1, const float* w2);
+
+        // Defined in the per-ISA translation units; nullptr when compiled out.
+        const FftKernels* Sse2FftKernels();
+        const FftKernels* Avx2FftKernels();
+        const FftKernels* NeonFftKernels();
+    }  // namespace detail
+
+}  // namespace core::dsp
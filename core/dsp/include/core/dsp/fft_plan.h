@@ -0,0 +1,50 @@
+#pragma once
+
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+#include "core/dsp/fft_kernels.h"
+
+namespace core::dsp {
+
+    // Precomputed FFT plan for one size.
+    // Built once per n_fft; each transform then costs only butterflies and table loads.
+    // - size must be a power of 2
+    // - forward FFT (no 1/N normalization), same result as FftRadix2
+    // - stages run as radix-4 passes (two fused radix-2 stages) plus one radix-2 pass
+    //   when log2(n) is odd, using the SIMD kernels picked for the running CPU
+    class FftPlan {
+    public:
+        // kernels == nullptr: ActiveFftKernels()
+        explicit FftPlan(int n, const FftKernels* kernels = nullptr);
+
+        int size() const { return n_; }
+        SimdIsa isa() const { return kernels_->isa; }
+
+        // In-place transform of size() points.
+        void Forward(std::complex<float>* data) const;
+
+        // Out-of-place transform: `in` is gathered in bit-reversed order into `out`
+        // (no swap pass), then transformed in `out`. `in` and `out` must not alias.
+        void Forward(const std::complex<float>* in, std::complex<float>* out) const;
+
+        // Work buffer of size() points owned by the plan (e.g. packed real-FFT input).
+        std::complex<float>* scratch() { return scratch_.data(); }
+
+    private:
+        void Butterflies(std::complex<float>* a) const;
+
+        int n_ = 0;
+        const FftKernels* kernels_ = nullptr;
+
+        // Per-stage twiddles, contiguous: the stage with half-size h (len = 2h)
+        // uses twiddles_[h-1 .. 2h-2] = exp(-2*pi*i*j/(2h)), j in [0, h). Total n-1 entries.
+        std::vector<std::complex<float>> twiddles_;
+
+        std::vector<std::uint32_t> bitrev_;  // bitrev_[i] = bit-reversed i
+        std::vector<std::uint32_t> swaps_;   // flattened (i, j) pairs with i < j
+        std::vector<std::complex<float>> scratch_;
+    };
+
+}  // namespace core::dsp
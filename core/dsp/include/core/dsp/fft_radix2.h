@@ -14,6 +14,8 @@ namespace core::dsp {
     // In-place radix-2 Cooley-Tukey FFT
     // - size must be power of 2
     // - forward FFT (no 1/N normalization)
+    // - one-shot: twiddles and bit-reversal are recomputed on every call;
+    //   per-hop code should hold an FftPlan (core/dsp/fft_plan.h) instead
     inline void FftRadix2(std::vector<std::complex<float>>& a) {
         const std::size_t n = a.size();
         if (n <= 1) return;
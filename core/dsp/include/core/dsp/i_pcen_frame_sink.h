@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace core::dsp {
+
+// Destination for PCEN frames (n_mels floats each).
+// PcenExtractor writes every frame once, straight into the storage the sink hands out:
+//   float* dst = sink->AcquireFrame();  // fill n_mels floats
+//   sink->CommitFrame(t_ns);            // publish, stamped with the frame's start time
+class IPcenFrameSink {
+ public:
+  virtual ~IPcenFrameSink() = default;
+
+  // Storage for the next frame, or nullptr if the sink cannot take more (frame is dropped).
+  virtual float* AcquireFrame() = 0;
+
+  // Publishes the frame written through the last AcquireFrame() pointer.
+  // t_ns: time of the frame's first sample (sinks that keep no time ignore it).
+  virtual void CommitFrame(std::int64_t t_ns) = 0;
+};
+
+// Writes into a caller-supplied buffer of max_frames * n_mels floats; full -> drops.
+class SpanFrameSink final : public IPcenFrameSink {
+ public:
+  SpanFrameSink(float* data, int max_frames, int n_mels)
+      : data_(data), max_frames_(max_frames), n_mels_(n_mels) {}
+
+  float* AcquireFrame() override {
+    if (!data_ || frames_ >= max_frames_) return nullptr;
+    return data_ + static_cast<std::size_t>(frames_) * static_cast<std::size_t>(n_mels_);
+  }
+  void CommitFrame(std::int64_t /*t_ns*/) override { ++frames_; }
+
+  int frames() const { return frames_; }
+  void Reset() { frames_ = 0; }
+
+ private:
+  float* data_ = nullptr;
+  int max_frames_ = 0;
+  int n_mels_ = 0;
+  int frames_ = 0;
+};
+
+// Appends to a std::vector (row-major [frame0(mels), frame1(mels), ...]).
+class VectorFrameSink final : public IPcenFrameSink {
+ public:
+  VectorFrameSink(std::vector<float>* out, int n_mels) : out_(out), n_mels_(n_mels) {}
+
+  float* AcquireFrame() override {
+    if (!out_) return nullptr;
+    const std::size_t off = out_->size();
+    out_->resize(off + static_cast<std::size_t>(n_mels_));
+    return out_->data() + off;
+  }
+  void CommitFrame(std::int64_t /*t_ns*/) override {}
+
+ private:
+  std::vector<float>* out_ = nullptr;
+  int n_mels_ = 0;
+};
+
+}  // namespace core::dsp
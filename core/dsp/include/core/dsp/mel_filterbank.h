@@ -20,16 +20,30 @@ namespace core::dsp {
 		int n_mels() const { return cfg_.n_mels; }
 		int n_freqs() const { return n_freqs_; }
 
+		// Total stored (nonzero-span) weights over all bands.
+		int n_weights() const { return static_cast<int>(weights_.size()); }
+
 		// power: size n_freqs = n_fft/2+1
 		// out_mel: size n_mels
 		void Apply(const float* power, float* out_mel) const;
 
+		// Batched projection: power [n_frames][n_freqs] -> out_mel [n_frames][n_mels].
+		// Band-major loop, so each band's weights stay in registers across all frames.
+		void ApplyBatch(const float* power, int n_frames, float* out_mel) const;
+
 	private:
+		// Nonzero span of one triangle: bins [start, start+length), weights at weights_[offset...]
+		struct Band {
+			int start = 0;
+			int length = 0;
+			int offset = 0;
+		};
+
 		MelFilterbankConfig cfg_{};
 		int n_freqs_ = 0;
 
-		// Dense weights [n_mels][n_freqs]
-		std::vector<float> w_;  // row-major: w_[m*n_freqs + k]
+		std::vector<Band> bands_;      // n_mels
+		std::vector<float> weights_;   // all bands back to back
 
 		static float HzToMel(float hz);
 		static float MelToHz(float mel);
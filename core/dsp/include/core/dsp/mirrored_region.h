@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+
+namespace core::dsp {
+
+    // Memory region mapped twice back to back (Linux memfd + two MAP_FIXED views):
+    // bytes [size, 2*size) alias [0, size), so any run of up to `size` bytes that
+    // starts in the first half can be read or written as one contiguous block.
+    // Allocate() fails (returns false) where this is not available; callers fall
+    // back to a plain buffer. Move-only; unmapped in Release() / destructor.
+    class MirroredRegion {
+    public:
+        MirroredRegion() = default;
+        ~MirroredRegion();
+
+        MirroredRegion(const MirroredRegion&) = delete;
+        MirroredRegion& operator=(const MirroredRegion&) = delete;
+        MirroredRegion(MirroredRegion&& other) noexcept;
+        MirroredRegion& operator=(MirroredRegion&& other) noexcept;
+
+        // `size` must be a multiple of PageSize(); contents start zeroed.
+        bool Allocate(std::size_t size);
+        void Release();
+
+        static bool Supported();
+        static std::size_t PageSize();
+
+        void* data() const { return data_; }
+        std::size_t size() const { return size_; }  // one copy; the mapping spans 2*size
+
+    private:
+        void* data_ = nullptr;
+        std::size_t size_ = 0;
+    };
+
+}  // namespace core::dsp
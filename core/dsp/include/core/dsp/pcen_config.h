@@ -0,0 +1,52 @@
+#pragma once
+
+namespace core::dsp {
+
+struct PcenConfig {
+  int sample_rate = 16000;
+  int n_fft = 512;      // power of two
+  int win_length = 400; // 25ms @16k
+  int hop_length = 160; // 10ms @16k
+  int n_mels = 64;
+
+  // PCEN params (reasonable defaults)
+  float eps = 1e-6f;
+  float alpha = 0.98f;
+  float delta = 2.0f;
+  float r = 0.5f;
+  float s = 0.025f;   // smoothing coefficient (0..1), ~tau
+  float floor = 1e-12f;
+
+  float f_min = 50.0f;
+  float f_max = 7600.0f;
+
+  // Vectorized PCEN compression with fast exp/log (see pcen_kernel.h for the error bound).
+  // false = std::pow reference.
+  bool fast_pcen = true;
+
+  // Real-input FFT (packed N/2 transform). false = full complex FFT (reference path).
+  bool real_fft = true;
+
+  // When several hops are ready in one Process() call (large chunk, offline file,
+  // catch-up after a stall), run each stage over up to this many frames at once.
+  // 1 = frame by frame.
+  int max_batch_frames = 8;
+};
+
+// The PCEN parameters of PcenConfig without the frame shape, for extractors whose shape
+// is fixed at compile time (PcenExtractorT). Same defaults as PcenConfig.
+struct PcenParams {
+  float eps = PcenConfig{}.eps;
+  float alpha = PcenConfig{}.alpha;
+  float delta = PcenConfig{}.delta;
+  float r = PcenConfig{}.r;
+  float s = PcenConfig{}.s;
+  float floor = PcenConfig{}.floor;
+  bool fast_pcen = PcenConfig{}.fast_pcen;
+};
+
+inline PcenParams ParamsOf(const PcenConfig& cfg) {
+  return PcenParams{cfg.eps, cfg.alpha, cfg.delta, cfg.r, cfg.s, cfg.floor, cfg.fast_pcen};
+}
+
+}  // namespace core::dsp
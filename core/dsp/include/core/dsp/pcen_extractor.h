@@ -3,29 +3,15 @@
 #include <complex>
 #include <cstdint>
 
+#include "core/dsp/fft_plan.h"
+#include "core/dsp/i_pcen_frame_sink.h"
 #include "core/dsp/mel_filterbank.h"
+#include "core/dsp/pcen_config.h"
+#include "core/dsp/pcen_kernel.h"
+#include "core/dsp/real_fft.h"
 
 namespace core::dsp {
 
-struct PcenConfig {
-  int sample_rate = 16000;
-  int n_fft = 512;      // power of two
-  int win_length = 400; // 25ms @16k
-  int hop_length = 160; // 10ms @16k
-  int n_mels = 64;
-
-  // PCEN params (reasonable defaults)
-  float eps = 1e-6f;
-  float alpha = 0.98f;
-  float delta = 2.0f;
-  float r = 0.5f;
-  float s = 0.025f;   // smoothing coefficient (0..1), ~tau
-  float floor = 1e-12f;
-
-  float f_min = 50.0f;
-  float f_max = 7600.0f;
-};
-
 // Streaming: feed PCM float mono, get PCEN mel frames at hop rate.
 class PcenExtractor {
  public:
@@ -33,24 +19,49 @@ class PcenExtractor {
 
   int n_mels() const { return cfg_.n_mels; }
 
-  // Push mono samples. Returns number of produced frames.
-  // Frames are appended to `out_frames` as row-major: [frame0(mels), frame1(mels), ...]
+  // Back to the freshly constructed state (empty history, smoother at 0), e.g. between files.
+  void Reset();
+
+  // Push mono samples. Returns number of frames delivered to the sink.
+  // Each frame is written once, directly into the sink's storage (e.g. a PcenRingBuffer slot).
+  // t0_ns is the time of mono[0]; every frame is committed with the time of its first sample.
+  int Process(const float* mono, int n, IPcenFrameSink* sink, std::int64_t t0_ns = 0);
+
+  // Same, frames appended to `out_frames` as row-major: [frame0(mels), frame1(mels), ...]
   int Process(const float* mono, int n, std::vector<float>* out_frames);
 
  private:
   PcenConfig cfg_;
   MelFilterbank mel_;
+  RealFft rfft_;
+  FftPlan cfft_;  // complex path only (size 1 when real_fft is on)
+  PcenKernel pcen_kernel_;
+
+  // Input history as a fixed circular buffer indexed by absolute sample number
+  // (capacity: power of 2 >= win_length + (batch-1)*hop). Windows are read from it in
+  // at most two runs, so a hop never shifts data and Process() never reallocates.
+  std::vector<float> ring_;
+  std::size_t ring_mask_ = 0;
+  std::int64_t written_ = 0;     // samples received so far
+  std::int64_t next_start_ = 0;  // first sample of the next frame
+  int hop_ = 1;                  // hop_length clamped to >= 1
+  std::int64_t t0_ns_ = 0;       // time of sample t0_sample_ (current Process call)
+  std::int64_t t0_sample_ = 0;
 
-  std::vector<float> in_fifo_;
   std::vector<float> window_;
-  std::vector<std::complex<float>> fft_buf_;
-  std::vector<float> power_;
-  std::vector<float> mel_energy_;
-  std::vector<float> pcen_m_;
-  std::vector<float> pcen_frame_;
+  std::vector<float> fft_in_;                 // windowed + zero-padded frame (n_fft)
+  std::vector<std::complex<float>> fft_buf_;  // complex path: n_fft; real path: n_fft/2+1 bins
+  int batch_ = 1;                       // effective max_batch_frames
+  std::vector<float> power_;            // [batch][n_fft/2+1]
+  std::vector<float> mel_energy_;       // [batch][n_mels]
+  std::vector<float> pcen_m_;           // smoother state [n_mels]
+  std::vector<float> pcen_m_batch_;     // smoother output per frame [batch][n_mels]
 
   void ComputeHann();
-  void OneFrame(const float* frame_win, float* out_pcen);
+  void LoadFrame(std::int64_t start);
+  void Spectrum(std::int64_t start, float* out_power);
+  int PcenBatch(int n_frames, IPcenFrameSink* sink);
+  std::int64_t FrameTimeNs(std::int64_t start) const;
 };
 
 }  // namespace core::dsp
@@ -0,0 +1,428 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <numbers>
+#include <utility>
+#include <vector>
+
+#include "core/dsp/constexpr_math.h"
+#include "core/dsp/fft_radix2.h"  // kPi
+#include "core/dsp/i_pcen_frame_sink.h"
+#include "core/dsp/pcen_config.h"
+#include "core/dsp/pcen_kernel.h"
+#include "core/dsp/fft_plan.h"
+
+namespace core::dsp {
+
+namespace detail {
+
+// Compile-time versions of the PcenExtractor / MelFilterbank / RealFft tables.
+// Same float arithmetic as the runtime construction: mel and twiddle tables are identical;
+// Hann entries are correctly rounded, so a few differ by 1 ulp from the std::cos(float) ones.
+
+struct MelBandT {
+  int start = 0;
+  int length = 0;
+  int offset = 0;
+};
+
+template <int NMels, int NWeights>
+struct MelTablesT {
+  std::array<MelBandT, NMels> bands{};
+  std::array<float, NWeights> weights{};
+};
+
+constexpr float CxHzToMel(float hz) {
+  return 2595.0f * static_cast<float>(cx::Log10(static_cast<double>(1.0f + hz / 700.0f)));
+}
+
+constexpr float CxMelToHz(float mel) {
+  return 700.0f * (static_cast<float>(cx::Pow10(static_cast<double>(mel / 2595.0f))) - 1.0f);
+}
+
+template <int SampleRate, int NFft, int NMels, int FMinHz, int FMaxHz>
+constexpr std::array<int, NMels + 2> MelBinsT() {
+  constexpr int n_freqs = NFft / 2 + 1;
+  const float f_min = std::max(0.0f, static_cast<float>(FMinHz));
+  const float f_max = std::min(static_cast<float>(FMaxHz), 0.5f * static_cast<float>(SampleRate));
+  const float mel_min = CxHzToMel(f_min);
+  const float mel_max = CxHzToMel(f_max);
+
+  std::array<int, NMels + 2> bin{};
+  for (int i = 0; i < NMels + 2; ++i) {
+    const float t = static_cast<float>(i) / static_cast<float>(NMels + 1);
+    const float hz = CxMelToHz(mel_min + t * (mel_max - mel_min));
+    const int b = static_cast<int>(cx::Floor((NFft + 1) * hz / SampleRate));
+    bin[static_cast<std::size_t>(i)] = std::clamp(b, 0, n_freqs - 1);
+  }
+  return bin;
+}
+
+// Triangle value of band (left, center, right) at bin k in [left, right]
+constexpr float MelWeightT(int left, int center, int right, int k) {
+  if (k < center) return static_cast<float>(k - left) / static_cast<float>(center - left);
+  return (right > center) ? static_cast<float>(right - k) / static_cast<float>(right - center) : 0.0f;
+}
+
+// Calls fn(m, first, last, left, center, right) for every band with a nonzero span
+template <int SampleRate, int NFft, int NMels, int FMinHz, int FMaxHz, class Fn>
+constexpr void ForEachMelBandT(Fn&& fn) {
+  const auto bin = MelBinsT<SampleRate, NFft, NMels, FMinHz, FMaxHz>();
+  for (int m = 0; m < NMels; ++m) {
+    const int left = bin[static_cast<std::size_t>(m)];
+    const int center = bin[static_cast<std::size_t>(m + 1)];
+    const int right = bin[static_cast<std::size_t>(m + 2)];
+    if (right <= left) continue;
+
+    int first = left;
+    int last = right;
+    while (first <= last && MelWeightT(left, center, right, first) == 0.0f) ++first;
+    while (last >= first && MelWeightT(left, center, right, last) == 0.0f) --last;
+    if (first > last) continue;
+    fn(m, first, last, left, center, right);
+  }
+}
+
+template <int SampleRate, int NFft, int NMels, int FMinHz, int FMaxHz>
+constexpr int MelWeightCountT() {
+  int count = 0;
+  ForEachMelBandT<SampleRate, NFft, NMels, FMinHz, FMaxHz>(
+      [&](int, int first, int last, int, int, int) { count += last - first + 1; });
+  return count;
+}
+
+template <int SampleRate, int NFft, int NMels, int FMinHz, int FMaxHz, int NWeights>
+constexpr MelTablesT<NMels, NWeights> BuildMelTablesT() {
+  MelTablesT<NMels, NWeights> t{};
+  int offset = 0;
+  ForEachMelBandT<SampleRate, NFft, NMels, FMinHz, FMaxHz>(
+      [&](int m, int first, int last, int left, int center, int right) {
+        MelBandT& b = t.bands[static_cast<std::size_t>(m)];
+        b.start = first;
+        b.length = last - first + 1;
+        b.offset = offset;
+        for (int k = first; k <= last; ++k) {
+          t.weights[static_cast<std::size_t>(offset++)] = MelWeightT(left, center, right, k);
+        }
+      });
+  return t;
+}
+
+template <int Win>
+constexpr std::array<float, Win> HannT() {
+  std::array<float, Win> w{};
+  for (int i = 0; i < Win; ++i) {
+    const float x = static_cast<float>(i) / static_cast<float>(Win - 1);
+    w[static_cast<std::size_t>(i)] = 0.5f - 0.5f * static_cast<float>(cx::Cos(static_cast<double>(2.0f * kPi * x)));
+  }
+  return w;
+}
+
+// RealFft split twiddles exp(-2*pi*i*k/N), k in [0, N/2), interleaved (re, im)
+template <int NFft>
+constexpr std::array<float, NFft> SplitTwiddlesT() {
+  std::array<float, NFft> w{};
+  const double step = -2.0 * std::numbers::pi / static_cast<double>(NFft);
+  for (int k = 0; k < NFft / 2; ++k) {
+    const double ang = step * static_cast<double>(k);
+    w[static_cast<std::size_t>(2 * k)] = static_cast<float>(cx::Cos(ang));
+    w[static_cast<std::size_t>(2 * k + 1)] = static_cast<float>(cx::Sin(ang));
+  }
+  return w;
+}
+
+}  // namespace detail
+
+// PcenExtractor specialized at compile time for one fixed shape (win_length == n_fft).
+// Hann window and banded mel filterbank are constexpr tables, every loop bound is a
+// constant. The constructor takes only the PCEN parameters (PcenParams); there is no
+// runtime shape to disagree with the template. Output matches PcenExtractor with the
+// same shape to ~1e-7 (Hann rounding, see above).
+// PcenExtractor stays the generic path for any other configuration.
+template <int NFft, int NMels, int Hop, int SampleRate = 22050,
+          int FMinHz = 50, int FMaxHz = 7600, int MaxBatch = 8>
+class PcenExtractorT {
+ public:
+  static_assert(NFft >= 2 && std::has_single_bit(static_cast<unsigned>(NFft)), "NFft must be a power of 2");
+  static_assert(NMels > 0 && Hop > 0 && MaxBatch > 0, "bad PcenExtractorT shape");
+
+  static constexpr int kNFft = NFft;
+  static constexpr int kWin = NFft;
+  static constexpr int kHop = Hop;
+  static constexpr int kNFreqs = NFft / 2 + 1;
+  static constexpr int kNMels = NMels;
+  static constexpr int kBatch = MaxBatch;
+
+  // `cfg` with the template shape stamped in (sample_rate, n_fft, win, hop, n_mels, f_min/f_max)
+  static PcenConfig Shape(PcenConfig cfg) {
+    cfg.sample_rate = SampleRate;
+    cfg.n_fft = NFft;
+    cfg.win_length = kWin;
+    cfg.hop_length = Hop;
+    cfg.n_mels = NMels;
+    cfg.f_min = static_cast<float>(FMinHz);
+    cfg.f_max = static_cast<float>(FMaxHz);
+    cfg.real_fft = true;
+    cfg.max_batch_frames = MaxBatch;
+    return cfg;
+  }
+
+  // Full config of this extractor: the template shape plus `params`
+  static PcenConfig Shape(const PcenParams& params) {
+    PcenConfig cfg;
+    cfg.eps = params.eps;
+    cfg.alpha = params.alpha;
+    cfg.delta = params.delta;
+    cfg.r = params.r;
+    cfg.s = params.s;
+    cfg.floor = params.floor;
+    cfg.fast_pcen = params.fast_pcen;
+    return Shape(cfg);
+  }
+
+  explicit PcenExtractorT(const PcenParams& params);
+
+  static constexpr int n_mels() { return NMels; }
+
+  // Back to the freshly constructed state (empty history, smoother at 0), e.g. between files.
+  void Reset() {
+    written_ = 0;
+    next_start_ = 0;
+    std::fill(pcen_m_.begin(), pcen_m_.end(), 0.0f);
+  }
+
+  // Same contract as PcenExtractor::Process.
+  int Process(const float* mono, int n, IPcenFrameSink* sink, std::int64_t t0_ns = 0);
+  int Process(const float* mono, int n, std::vector<float>* out_frames);
+
+ private:
+  static constexpr int kRing = static_cast<int>(std::bit_ceil(static_cast<unsigned>(kWin + (MaxBatch - 1) * Hop)));
+  static constexpr std::size_t kRingMask = static_cast<std::size_t>(kRing) - 1;
+
+  static constexpr int kNWeights = detail::MelWeightCountT<SampleRate, NFft, NMels, FMinHz, FMaxHz>();
+  static constexpr auto kMel = detail::BuildMelTablesT<SampleRate, NFft, NMels, FMinHz, FMaxHz, kNWeights>();
+  static constexpr auto kHann = detail::HannT<kWin>();
+  static constexpr auto kSplitW = detail::SplitTwiddlesT<NFft>();
+
+  PcenConfig cfg_;
+  FftPlan plan_;  // NFft/2 points: real FFT as packed complex FFT + split (see RealFft)
+  PcenKernel pcen_kernel_;
+
+  std::vector<float> ring_;      // kRing
+  std::int64_t written_ = 0;
+  std::int64_t next_start_ = 0;
+  std::int64_t t0_ns_ = 0;      // time of sample t0_sample_ (current Process call)
+  std::int64_t t0_sample_ = 0;
+
+  std::vector<float> fft_in_;                 // kNFft
+  std::vector<float> power_;                  // [kBatch][kNFreqs]
+  std::vector<float> mel_energy_;             // [kBatch][NMels]
+  std::vector<float> pcen_m_;                 // [NMels]
+  std::vector<float> pcen_m_batch_;           // [kBatch][NMels]
+
+  void Spectrum(std::int64_t start, float* out_power);
+  template <std::size_t M>
+  static void MelBand(const float* power, int n_frames, float* out_mel);
+  template <std::size_t... M>
+  void MelBatch(std::index_sequence<M...>, int n_frames);
+  int PcenBatch(int n_frames, IPcenFrameSink* sink);
+};
+
+// ---- implementation ----
+
+template <int NFft, int NMels, int Hop, int SampleRate, int FMinHz, int FMaxHz, int MaxBatch>
+PcenExtractorT<NFft, NMels, Hop, SampleRate, FMinHz, FMaxHz, MaxBatch>::PcenExtractorT(const PcenParams& params)
+    : cfg_(Shape(params)),
+      plan_(NFft / 2),
+      pcen_kernel_(cfg_),
+      ring_(static_cast<std::size_t>(kRing), 0.0f),
+      fft_in_(static_cast<std::size_t>(kNFft), 0.0f),
+      power_(static_cast<std::size_t>(kBatch * kNFreqs), 0.0f),
+      mel_energy_(static_cast<std::size_t>(kBatch * NMels), 0.0f),
+      pcen_m_(static_cast<std::size_t>(NMels), 0.0f),
+      pcen_m_batch_(static_cast<std::size_t>(kBatch * NMels), 0.0f) {}
+
+template <int NFft, int NMels, int Hop, int SampleRate, int FMinHz, int FMaxHz, int MaxBatch>
+void PcenExtractorT<NFft, NMels, Hop, SampleRate, FMinHz, FMaxHz, MaxBatch>::Spectrum(std::int64_t start, float* out_power) {
+  // Hann-windowed frame; the window may wrap around the end of the ring
+  const std::size_t pos = static_cast<std::size_t>(start) & kRingMask;
+  const float* hann = kHann.data();
+  float* dst = fft_in_.data();
+  if (pos + kWin <= static_cast<std::size_t>(kRing)) {
+    const float* src = ring_.data() + pos;
+    for (int i = 0; i < kWin; ++i) dst[i] = src[i] * hann[i];
+  }
+  else {
+    const int n1 = kRing - static_cast<int>(pos);
+    const float* a = ring_.data() + pos;
+    for (int i = 0; i < n1; ++i) dst[i] = a[i] * hann[i];
+    const float* b = ring_.data();
+    for (int i = n1; i < kWin; ++i) dst[i] = b[i - n1] * hann[i];
+  }
+
+  // Packed N/2-point complex FFT of the real frame, result in plan_.scratch()
+  plan_.Forward(reinterpret_cast<const std::complex<float>*>(fft_in_.data()), plan_.scratch());
+
+  // RealFft split fused with the power spectrum, on plain floats.
+  // Same operation order as RealFft::Forward + PcenExtractor::Spectrum.
+  constexpr int half = NFft / 2;
+  constexpr float inv_n = 1.0f / static_cast<float>(NFft);
+  const float* z = reinterpret_cast<const float*>(plan_.scratch());
+  const float* w = kSplitW.data();
+  const float floor = cfg_.floor;
+
+  const float dc = (z[0] + z[1]) * inv_n;
+  const float ny = (z[0] - z[1]) * inv_n;
+  out_power[0] = std::max(floor, dc * dc + 0.0f);  // + im*im with im = 0
+  out_power[half] = std::max(floor, ny * ny + 0.0f);
+
+  // Bins k and N/2-k from the same two packed values (see RealFft::Forward)
+  for (int k = 1; k <= half / 2; ++k) {
+    const int kc = half - k;
+    const float ar = z[2 * k];
+    const float ai = z[2 * k + 1];
+    const float br = z[2 * kc];
+    const float bi = z[2 * kc + 1];
+
+    const float even_r = 0.5f * (ar + br);
+    const float even_i = 0.5f * (ai - bi);
+    const float odd_r = 0.5f * (ai + bi);
+    const float odd_i = -0.5f * (ar - br);
+
+    const float wr = w[2 * k];
+    const float wi = w[2 * k + 1];
+    const float t_r = wr * odd_r - wi * odd_i;
+    const float t_i = wr * odd_i + wi * odd_r;
+
+    const float re = (even_r + t_r) * inv_n;
+    const float im = (even_i + t_i) * inv_n;
+    const float re_c = (even_r - t_r) * inv_n;
+    const float im_c = (t_i - even_i) * inv_n;
+    out_power[k] = std::max(floor, re * re + im * im);
+    out_power[kc] = std::max(floor, re_c * re_c + im_c * im_c);
+  }
+}
+
+template <int NFft, int NMels, int Hop, int SampleRate, int FMinHz, int FMaxHz, int MaxBatch>
+template <std::size_t M>
+void PcenExtractorT<NFft, NMels, Hop, SampleRate, FMinHz, FMaxHz, MaxBatch>::MelBand(const float* power, int n_frames, float* out_mel) {
+  // Band span and weights are compile-time constants: the inner loop is fully unrolled
+  constexpr detail::MelBandT band = kMel.bands[M];
+  const float* w = kMel.weights.data() + band.offset;
+
+  for (int f = 0; f < n_frames; ++f) {
+    const float* p = power + f * kNFreqs + band.start;
+    // same summation order as MelFilterbank::Apply
+    float acc0 = 0.0f, acc1 = 0.0f, acc2 = 0.0f, acc3 = 0.0f;
+    int k = 0;
+    for (; k + 4 <= band.length; k += 4) {
+      acc0 += w[k] * p[k];
+      acc1 += w[k + 1] * p[k + 1];
+      acc2 += w[k + 2] * p[k + 2];
+      acc3 += w[k + 3] * p[k + 3];
+    }
+    for (; k < band.length; ++k) {
+      acc0 += w[k] * p[k];
+    }
+    out_mel[f * NMels + static_cast<int>(M)] = (acc0 + acc1) + (acc2 + acc3);
+  }
+}
+
+template <int NFft, int NMels, int Hop, int SampleRate, int FMinHz, int FMaxHz, int MaxBatch>
+template <std::size_t... M>
+void PcenExtractorT<NFft, NMels, Hop, SampleRate, FMinHz, FMaxHz, MaxBatch>::MelBatch(std::index_sequence<M...>, int n_frames) {
+  // One specialized routine per band
+  (MelBand<M>(power_.data(), n_frames, mel_energy_.data()), ...);
+}
+
+template <int NFft, int NMels, int Hop, int SampleRate, int FMinHz, int FMaxHz, int MaxBatch>
+int PcenExtractorT<NFft, NMels, Hop, SampleRate, FMinHz, FMaxHz, MaxBatch>::PcenBatch(int n_frames, IPcenFrameSink* sink) {
+  const float s = cfg_.s;
+  const float floor = cfg_.floor;
+  float* M = pcen_m_.data();
+  for (int f = 0; f < n_frames; ++f) {
+    const float* E = mel_energy_.data() + f * NMels;
+    float* M_out = pcen_m_batch_.data() + f * NMels;
+    for (int m = 0; m < NMels; ++m) {
+      M[m] = (1.0f - s) * M[m] + s * std::max(floor, E[m]);
+      M_out[m] = M[m];
+    }
+  }
+
+  int delivered = 0;
+  for (int f = 0; f < n_frames; ++f) {
+    float* dst = sink->AcquireFrame();
+    if (!dst) continue;
+    const std::size_t off = static_cast<std::size_t>(f * NMels);
+    pcen_kernel_.Compress(&mel_energy_[off], &pcen_m_batch_[off], dst, static_cast<std::size_t>(NMels));
+    const std::int64_t start = next_start_ + static_cast<std::int64_t>(f) * Hop;
+    sink->CommitFrame(t0_ns_ + (start - t0_sample_) * 1'000'000'000LL / SampleRate);
+    ++delivered;
+  }
+  return delivered;
+}
+
+template <int NFft, int NMels, int Hop, int SampleRate, int FMinHz, int FMaxHz, int MaxBatch>
+int PcenExtractorT<NFft, NMels, Hop, SampleRate, FMinHz, FMaxHz, MaxBatch>::Process(const float* mono, int n, std::vector<float>* out_frames) {
+  if (!out_frames) return 0;
+  VectorFrameSink sink(out_frames, NMels);
+  return Process(mono, n, &sink);
+}
+
+template <int NFft, int NMels, int Hop, int SampleRate, int FMinHz, int FMaxHz, int MaxBatch>
+int PcenExtractorT<NFft, NMels, Hop, SampleRate, FMinHz, FMaxHz, MaxBatch>::Process(const float* mono, int n, IPcenFrameSink* sink, std::int64_t t0_ns) {
+  if (!sink) return 0;
+  t0_ns_ = t0_ns;
+  t0_sample_ = written_;
+
+  int left = std::max(0, n);
+  int produced = 0;
+
+  for (;;) {
+    // hop > win: samples between windows are never needed
+    if (written_ < next_start_ && left > 0) {
+      const int skip = static_cast<int>(std::min<std::int64_t>(left, next_start_ - written_));
+      mono += skip;
+      left -= skip;
+      written_ += skip;
+    }
+
+    // Append as much as fits behind the oldest sample still needed
+    const std::int64_t used = std::max<std::int64_t>(0, written_ - next_start_);
+    const int take = static_cast<int>(std::min<std::int64_t>(left, kRing - used));
+    if (take > 0) {
+      const std::size_t pos = static_cast<std::size_t>(written_) & kRingMask;
+      const std::size_t n1 = std::min(static_cast<std::size_t>(take), static_cast<std::size_t>(kRing) - pos);
+      std::memcpy(ring_.data() + pos, mono, n1 * sizeof(float));
+      std::memcpy(ring_.data(), mono + n1, (static_cast<std::size_t>(take) - n1) * sizeof(float));
+      mono += take;
+      left -= take;
+      written_ += take;
+    }
+
+    const std::int64_t avail = written_ - next_start_;
+    if (avail < kWin) {
+      if (left > 0) continue;
+      break;
+    }
+
+    const int ready = 1 + static_cast<int>((avail - kWin) / Hop);
+    const int k = std::min(ready, kBatch);
+
+    for (int f = 0; f < k; ++f) {
+      Spectrum(next_start_ + static_cast<std::int64_t>(f) * Hop, &power_[static_cast<std::size_t>(f * kNFreqs)]);
+    }
+    MelBatch(std::make_index_sequence<NMels>{}, k);
+    produced += PcenBatch(k, sink);
+
+    next_start_ += static_cast<std::int64_t>(k) * Hop;
+  }
+
+  return produced;
+}
+
+}  // namespace core::dsp
@@ -0,0 +1,28 @@
+#pragma once
+#include <cmath>
+
+#include "core/dsp/pcen_config.h"
+#include "core/dsp/pcen_extractor_t.h"
+
+namespace core::dsp {
+
+// Production feature set: 22050 Hz, n_fft = win = 1024, hop 256, 128 mels.
+// Shared by the live pipeline (apps/qt_gui) and offline extraction (apps/uav_extract),
+// so training tensors match what the detector sees at runtime.
+using ProductionPcenExtractor = PcenExtractorT</*NFft=*/1024, /*NMels=*/128, /*Hop=*/256, /*SampleRate=*/22050>;
+
+inline PcenConfig ProductionPcenConfig() {
+  PcenConfig cfg = ProductionPcenExtractor::Shape(PcenConfig{});
+  cfg.alpha = 0.6f;
+  cfg.delta = 2.0f;
+  cfg.r = 0.1f;
+  cfg.eps = 1e-6f;
+
+  // smoother: time constant 0.4 s at the hop rate
+  const float time_constant = 0.4f;
+  const float hop_sec = static_cast<float>(cfg.hop_length) / static_cast<float>(cfg.sample_rate);
+  cfg.s = 1.0f - std::exp(-hop_sec / time_constant);
+  return cfg;
+}
+
+}  // namespace core::dsp
@@ -1,29 +1,110 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <vector>
-#include <mutex>
+
+#include "core/dsp/i_pcen_frame_sink.h"
+#include "core/dsp/mirrored_region.h"
 
 namespace core::dsp {
 
+	// The last frames of a PcenRingBuffer as they sit in ring storage (no copy):
+	// `first` then `second` (wrap-around part, may be empty), oldest frame first.
+	// The writer may overwrite them at any time: read the data, then check
+	// PcenRingBuffer::Validate(view); on false discard what was read and take a new view.
+	struct PcenRingView {
+		const float* first = nullptr;
+		int first_frames = 0;
+		const float* second = nullptr;
+		int second_frames = 0;
+		std::uint64_t first_seq = 0; // absolute number of the oldest frame
+
+		int frames() const { return first_frames + second_frames; }
+	};
+
+	// Result of PcenRingBuffer::CopyRange
+	struct PcenRangeCopy {
+		std::uint64_t first_seq = 0; // sequence number of the first copied frame
+		int frames = 0;              // frames copied
+		int lost_frames = 0;         // requested frames already overwritten (before first_seq)
+	};
+
 	// Ring buffer of PCEN frames (each frame has n_mels floats)
-	class PcenRingBuffer {
+	// Frames are numbered by a monotonic sequence number (0 = first frame ever pushed)
+	// and carry the timestamp they were committed with.
+	// Single writer (audio thread), any number of readers, no locks (seqlock per slot):
+	// - slot stamp is 2f+1 while frame f is being written, 2f+2 once it is complete
+	// - head_ counts committed frames; a reader copies the frames it wants, then re-checks
+	//   the oldest one's stamp and retries if the writer got there meanwhile
+	// The writer never waits for readers: push cost is one frame copy plus three atomic stores.
+	// Also a frame sink: PcenExtractor can write frames directly into ring slots.
+	//
+	// Mirrored backing (optional): storage is mapped twice back to back (MirroredRegion),
+	// so ViewLast() always returns a single contiguous run that can be handed to the model
+	// as is. The slot count is then rounded up to whole pages (only capacity_frames are
+	// ever returned). Falls back to a heap buffer where mirroring is unavailable.
+	class PcenRingBuffer : public IPcenFrameSink {
 	public:
-		PcenRingBuffer(int n_mels, int capacity_frames);
+		PcenRingBuffer(int n_mels, int capacity_frames, bool mirrored = false);
+
+		void PushFrame(const float* frame, std::int64_t t_ns = 0); // size n_mels
+
+		// IPcenFrameSink (writer side): the acquired slot is stamped "in progress"
+		// until CommitFrame(), so readers never return it half-written.
+		float* AcquireFrame() override;
+		void CommitFrame(std::int64_t t_ns) override;
 
-		void PushFrame(const float* frame); // size n_mels
+		// Copy of the last frames (allocates; prefer CopyLast on periodic paths)
 		std::vector<float> SnapshotLast(int last_frames, int* out_frames) const;
 
+		// Copies up to last_frames newest frames into dst ([frames][n_mels], room for
+		// dst_frames frames), oldest first. Returns frames copied. No allocation.
+		int CopyLast(int last_frames, float* dst, int dst_frames) const;
+
+		// Zero-copy access, see PcenRingView. Returns false if nothing is readable.
+		// With mirrored backing second_frames is always 0.
+		bool ViewLast(int last_frames, PcenRingView* out) const;
+		bool Validate(const PcenRingView& view) const;
+
+		// Frames [first_seq, end_seq) by sequence number; end_seq is clamped to frames_written().
+		// Frames already overwritten are skipped and reported in lost_frames. dst gets up to
+		// dst_frames frames, t_ns_out (optional) their timestamps. No allocation.
+		PcenRangeCopy CopyRange(std::uint64_t first_seq, std::uint64_t end_seq,
+			float* dst, int dst_frames, std::int64_t* t_ns_out = nullptr) const;
+
+		// Timestamp of frame `seq`; false if it is not (or no longer) in the ring.
+		bool FrameTime(std::uint64_t seq, std::int64_t* t_ns) const;
+
 		int n_mels() const { return n_mels_; }
 		int capacity_frames() const { return capacity_frames_; }
+		bool mirrored() const { return mirror_.data() != nullptr; }
+
+		// Frames committed since construction (= sequence number of the next frame)
+		std::uint64_t frames_written() const { return head_.load(std::memory_order_acquire); }
+		// Reader retries caused by concurrent writes (contention metric)
+		std::uint64_t read_retries() const { return read_retries_.load(std::memory_order_relaxed); }
 
 	private:
+		// View of [first_seq, end_seq) clamped to what is readable; lost = frames before it
+		bool ViewRange(std::uint64_t first_seq, std::uint64_t end_seq, PcenRingView* out, int* lost) const;
+
+		// A reader that keeps colliding with the writer gives up (returns 0 frames)
+		static constexpr int kMaxReadAttempts = 64;
+
 		int n_mels_{ 0 };
 		int capacity_frames_{ 0 };
+		int slots_{ 0 }; // storage frames (>= capacity_frames with mirrored backing)
+
+		MirroredRegion mirror_;   // mirrored backing, or
+		std::vector<float> heap_; // plain backing (slots * n_mels)
+		float* data_{ nullptr };
+		std::unique_ptr<std::atomic<std::uint64_t>[]> seq_; // per-slot stamp
+		std::unique_ptr<std::int64_t[]> t_ns_;              // per-slot frame time (under the stamp)
 
-		mutable std::mutex mu_;
-		std::vector<float> data_; // capacity_frames * n_mels
-		int write_idx_{ 0 };        // frame index (0..capacity_frames-1)
-		int size_frames_{ 0 };      // filled frames
+		alignas(64) std::atomic<std::uint64_t> head_{ 0 };
+		alignas(64) mutable std::atomic<std::uint64_t> read_retries_{ 0 };
 	};
 
 }  // namespace core::dsp
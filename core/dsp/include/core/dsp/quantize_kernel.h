@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace core::dsp {
+
+    // Affine (per-tensor) quantization as used by int8/uint8 TFLite models:
+    //   q = clamp(round(x / scale) + zero_point, qmin, qmax),  x = (q - zero_point) * scale
+    //
+    // Quantize runs 16 values per step (SSE2 on x86-64, NEON on aarch64, scalar elsewhere).
+    // x is multiplied by 1/scale and rounded half to even; out-of-range values (and NaN)
+    // saturate. The SIMD and scalar paths give identical results (`uav_bench quantize_kernel`).
+    struct QuantParams {
+        float scale = 1.0f;
+        int zero_point = 0;
+    };
+
+    void QuantizeInt8(const float* src, std::size_t count, const QuantParams& q, std::int8_t* dst);
+    void QuantizeUint8(const float* src, std::size_t count, const QuantParams& q, std::uint8_t* dst);
+
+    // Scalar reference (the tail loop of the SIMD paths)
+    void QuantizeInt8Reference(const float* src, std::size_t count, const QuantParams& q, std::int8_t* dst);
+    void QuantizeUint8Reference(const float* src, std::size_t count, const QuantParams& q, std::uint8_t* dst);
+
+    // Scalar (model outputs are a handful of values)
+    void DequantizeInt8(const std::int8_t* src, std::size_t count, const QuantParams& q, float* dst);
+    void DequantizeUint8(const std::uint8_t* src, std::size_t count, const QuantParams& q, float* dst);
+
+}  // namespace core::dsp
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <complex>
+#include <vector>
+
+#include "core/dsp/fft_plan.h"
+
+namespace core::dsp {
+
+    // Forward FFT of a real signal.
+    // - n_fft must be a power of 2 (>= 2)
+    // - the N real samples are packed as N/2 complex values z[k] = x[2k] + i*x[2k+1],
+    //   transformed with an N/2-point complex FFT and then split into the N/2+1
+    //   one-sided bins of the N-point spectrum
+    // - no 1/N normalization (same convention as FftRadix2)
+    class RealFft {
+    public:
+        explicit RealFft(int n_fft);
+
+        int n_fft() const { return n_fft_; }
+        int n_bins() const { return n_fft_ / 2 + 1; }
+
+        // in: n_fft real samples
+        // out: n_fft/2+1 complex bins
+        void Forward(const float* in, std::complex<float>* out);
+
+    private:
+        int n_fft_ = 0;
+
+        FftPlan plan_;                              // N/2-point plan; its scratch holds the packed transform
+        std::vector<std::complex<float>> split_w_;  // exp(-2*pi*i*k/N), k in [0, N/2)
+    };
+
+}  // namespace core::dsp
@@ -0,0 +1,165 @@
+#include "core/dsp/fft_kernels.h"
+
+#include <complex>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define UAV_FFT_X86_64 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+#else
+#define UAV_FFT_X86_64 0
+#endif
+
+namespace core::dsp {
+
+    namespace detail {
+
+        void ScalarRadix2(float* a, std::size_t n, std::size_t h, const float* w) {
+            for (std::size_t i = 0; i < n; i += 2 * h) {
+                float* lo = a + 2 * i;
+                float* hi = a + 2 * (i + h);
+                for (std::size_t j = 0; j < h; ++j) {
+                    const float wr = w[2 * j];
+                    const float wi = w[2 * j + 1];
+                    const float hr = hi[2 * j];
+                    const float him = hi[2 * j + 1];
+                    const float vr = hr * wr - him * wi;
+                    const float vi = hr * wi + him * wr;
+                    const float ur = lo[2 * j];
+                    const float ui = lo[2 * j + 1];
+                    lo[2 * j] = ur + vr;
+                    lo[2 * j + 1] = ui + vi;
+                    hi[2 * j] = ur - vr;
+                    hi[2 * j + 1] = ui - vi;
+                }
+            }
+        }
+
+        void ScalarRadix4(float* a, std::size_t n, std::size_t h, const float* w1, const float* w2) {
+            using C = std::complex<float>;
+            auto mul = [](C x, C w) {
+                return C(x.real() * w.real() - x.imag() * w.imag(),
+                    x.real() * w.imag() + x.imag() * w.real());
+                };
+
+            C* c = reinterpret_cast<C*>(a);
+            const C* t1 = reinterpret_cast<const C*>(w1);
+            const C* t2 = reinterpret_cast<const C*>(w2);
+
+            for (std::size_t i = 0; i < n; i += 4 * h) {
+                C* p0 = c + i;
+                C* p1 = p0 + h;
+                C* p2 = p0 + 2 * h;
+                C* p3 = p0 + 3 * h;
+                for (std::size_t j = 0; j < h; ++j) {
+                    // stage h: pairs (p0, p1) and (p2, p3)
+                    const C x1 = mul(p1[j], t1[j]);
+                    const C x3 = mul(p3[j], t1[j]);
+                    const C b0 = p0[j] + x1;
+                    const C b1 = p0[j] - x1;
+                    const C b2 = p2[j] + x3;
+                    const C b3 = p2[j] - x3;
+
+                    // stage 2h: pairs (p0, p2) with W, (p1, p3) with W * (-i)
+                    const C y2 = mul(b2, t2[j]);
+                    const C y3 = mul(b3, t2[j]);
+                    const C y3r(y3.imag(), -y3.real());
+
+                    p0[j] = b0 + y2;
+                    p2[j] = b0 - y2;
+                    p1[j] = b1 + y3r;
+                    p3[j] = b1 - y3r;
+                }
+            }
+        }
+
+    }  // namespace detail
+
+    namespace {
+
+        const FftKernels kScalarKernels{
+            .isa = SimdIsa::kScalar,
+            .radix2 = &detail::ScalarRadix2,
+            .radix4 = &detail::ScalarRadix4,
+        };
+
+#if UAV_FFT_X86_64
+        bool CpuHasAvx2Fma() {
+#if defined(_MSC_VER) && !defined(__clang__)
+            int r[4]{};
+            __cpuid(r, 0);
+            if (r[0] < 7) return false;
+
+            __cpuid(r, 1);
+            const bool fma = (r[2] & (1 << 12)) != 0;
+            const bool osxsave = (r[2] & (1 << 27)) != 0;
+            const bool avx = (r[2] & (1 << 28)) != 0;
+            if (!fma || !osxsave || !avx) return false;
+
+            // OS must save YMM state
+            if ((_xgetbv(0) & 0x6) != 0x6) return false;
+
+            __cpuidex(r, 7, 0);
+            return (r[1] & (1 << 5)) != 0;
+#else
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+        }
+#endif
+
+        const FftKernels* SelectFftKernels() {
+            if (const char* env = std::getenv("UAV_FFT_ISA"); env != nullptr && env[0] != '\0') {
+                for (SimdIsa isa : { SimdIsa::kScalar, SimdIsa::kSse2, SimdIsa::kAvx2, SimdIsa::kNeon }) {
+                    if (std::strcmp(env, SimdIsaName(isa)) == 0) {
+                        if (const FftKernels* k = GetFftKernels(isa)) return k;
+                    }
+                }
+            }
+
+            for (SimdIsa isa : { SimdIsa::kAvx2, SimdIsa::kNeon, SimdIsa::kSse2 }) {
+                if (const FftKernels* k = GetFftKernels(isa)) return k;
+            }
+            return &kScalarKernels;
+        }
+
+    }  // namespace
+
+    const char* SimdIsaName(SimdIsa isa) {
+        switch (isa) {
+        case SimdIsa::kScalar: return "scalar";
+        case SimdIsa::kSse2: return "sse2";
+        case SimdIsa::kAvx2: return "avx2";
+        case SimdIsa::kNeon: return "neon";
+        default: return "unknown";
+        }
+    }
+
+    const FftKernels* GetFftKernels(SimdIsa isa) {
+        switch (isa) {
+        case SimdIsa::kScalar:
+            return &kScalarKernels;
+        case SimdIsa::kSse2:
+            return detail::Sse2FftKernels();
+        case SimdIsa::kAvx2:
+#if UAV_FFT_X86_64
+            if (!CpuHasAvx2Fma()) return nullptr;
+#endif
+            return detail::Avx2FftKernels();
+        case SimdIsa::kNeon:
+            return detail::NeonFftKernels();
+        default:
+            return nullptr;
+        }
+    }
+
+    const FftKernels& ActiveFftKernels() {
+        static const FftKernels* active = SelectFftKernels();
+        return *active;
+    }
+
+}  // namespace core::dsp
@@ -0,0 +1,107 @@
+// Built with AVX2/FMA code generation (see CMake); only called after a runtime CPU check.
+#include "core/dsp/fft_kernels.h"
+
+#if defined(__AVX2__) && (defined(_M_X64) || defined(__x86_64__))
+#include <immintrin.h>
+#define UAV_FFT_HAVE_AVX2 1
+#else
+#define UAV_FFT_HAVE_AVX2 0
+#endif
+
+namespace core::dsp {
+
+#if UAV_FFT_HAVE_AVX2
+    namespace {
+
+        // 4 complex values per register: [r0, i0, r1, i1, r2, i2, r3, i3]
+
+        // x * w (complex, lane-wise)
+        inline __m256 Avx2Mul(__m256 x, __m256 w) {
+            const __m256 wr = _mm256_moveldup_ps(w);
+            const __m256 wi = _mm256_movehdup_ps(w);
+            const __m256 xs = _mm256_permute_ps(x, 0xB1);  // swap re/im
+            // even lanes: r*wr - i*wi, odd lanes: i*wr + r*wi
+            return _mm256_fmaddsub_ps(x, wr, _mm256_mul_ps(xs, wi));
+        }
+
+        // x * (-i) = (im, -re)
+        inline __m256 Avx2MulNegI(__m256 x, __m256 sign_odd) {
+            return _mm256_xor_ps(_mm256_permute_ps(x, 0xB1), sign_odd);
+        }
+
+        void Avx2Radix2(float* a, std::size_t n, std::size_t h, const float* w) {
+            if (h < 4) {
+                detail::ScalarRadix2(a, n, h, w);
+                return;
+            }
+            for (std::size_t i = 0; i < n; i += 2 * h) {
+                float* lo = a + 2 * i;
+                float* hi = a + 2 * (i + h);
+                for (std::size_t j = 0; j < 2 * h; j += 8) {
+                    const __m256 u = _mm256_loadu_ps(lo + j);
+                    const __m256 v = Avx2Mul(_mm256_loadu_ps(hi + j), _mm256_loadu_ps(w + j));
+                    _mm256_storeu_ps(lo + j, _mm256_add_ps(u, v));
+                    _mm256_storeu_ps(hi + j, _mm256_sub_ps(u, v));
+                }
+            }
+        }
+
+        void Avx2Radix4(float* a, std::size_t n, std::size_t h, const float* w1, const float* w2) {
+            if (h < 4) {
+                detail::ScalarRadix4(a, n, h, w1, w2);
+                return;
+            }
+            const __m256 sign_odd = _mm256_castsi256_ps(_mm256_set_epi32(
+                static_cast<int>(0x80000000u), 0, static_cast<int>(0x80000000u), 0,
+                static_cast<int>(0x80000000u), 0, static_cast<int>(0x80000000u), 0));
+
+            for (std::size_t i = 0; i < n; i += 4 * h) {
+                float* p0 = a + 2 * i;
+                float* p1 = p0 + 2 * h;
+                float* p2 = p0 + 4 * h;
+                float* p3 = p0 + 6 * h;
+                for (std::size_t j = 0; j < 2 * h; j += 8) {
+                    const __m256 t1 = _mm256_loadu_ps(w1 + j);
+                    const __m256 t2 = _mm256_loadu_ps(w2 + j);
+
+                    const __m256 a0 = _mm256_loadu_ps(p0 + j);
+                    const __m256 x1 = Avx2Mul(_mm256_loadu_ps(p1 + j), t1);
+                    const __m256 a2 = _mm256_loadu_ps(p2 + j);
+                    const __m256 x3 = Avx2Mul(_mm256_loadu_ps(p3 + j), t1);
+
+                    const __m256 b0 = _mm256_add_ps(a0, x1);
+                    const __m256 b1 = _mm256_sub_ps(a0, x1);
+                    const __m256 b2 = _mm256_add_ps(a2, x3);
+                    const __m256 b3 = _mm256_sub_ps(a2, x3);
+
+                    const __m256 y2 = Avx2Mul(b2, t2);
+                    const __m256 y3 = Avx2MulNegI(Avx2Mul(b3, t2), sign_odd);
+
+                    _mm256_storeu_ps(p0 + j, _mm256_add_ps(b0, y2));
+                    _mm256_storeu_ps(p2 + j, _mm256_sub_ps(b0, y2));
+                    _mm256_storeu_ps(p1 + j, _mm256_add_ps(b1, y3));
+                    _mm256_storeu_ps(p3 + j, _mm256_sub_ps(b1, y3));
+                }
+            }
+        }
+
+        const FftKernels kAvx2Kernels{
+            .isa = SimdIsa::kAvx2,
+            .radix2 = &Avx2Radix2,
+            .radix4 = &Avx2Radix4,
+        };
+
+    }  // namespace
+#endif
+
+    namespace detail {
+        const FftKernels* Avx2FftKernels() {
+#if UAV_FFT_HAVE_AVX2
+            return &kAvx2Kernels;
+#else
+            return nullptr;
+#endif
+        }
+    }  // namespace detail
+
+}  // namespace core::dsp
@@ -0,0 +1,118 @@
+#include "core/dsp/fft_kernels.h"
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define UAV_FFT_HAVE_NEON 1
+#else
+#define UAV_FFT_HAVE_NEON 0
+#endif
+
+namespace core::dsp {
+
+#if UAV_FFT_HAVE_NEON
+    namespace {
+
+        // vld2q/vst2q de-interleave 4 complex values into separate re/im registers,
+        // so the complex math is plain lane-wise FMA without shuffles.
+
+        inline float32x4x2_t NeonMul(float32x4x2_t x, float32x4x2_t w) {
+            float32x4x2_t r;
+            r.val[0] = vfmsq_f32(vmulq_f32(x.val[0], w.val[0]), x.val[1], w.val[1]);
+            r.val[1] = vfmaq_f32(vmulq_f32(x.val[0], w.val[1]), x.val[1], w.val[0]);
+            return r;
+        }
+
+        inline float32x4x2_t NeonAdd(float32x4x2_t x, float32x4x2_t y) {
+            float32x4x2_t r;
+            r.val[0] = vaddq_f32(x.val[0], y.val[0]);
+            r.val[1] = vaddq_f32(x.val[1], y.val[1]);
+            return r;
+        }
+
+        inline float32x4x2_t NeonSub(float32x4x2_t x, float32x4x2_t y) {
+            float32x4x2_t r;
+            r.val[0] = vsubq_f32(x.val[0], y.val[0]);
+            r.val[1] = vsubq_f32(x.val[1], y.val[1]);
+            return r;
+        }
+
+        void NeonRadix2(float* a, std::size_t n, std::size_t h, const float* w) {
+            if (h < 4) {
+                detail::ScalarRadix2(a, n, h, w);
+                return;
+            }
+            for (std::size_t i = 0; i < n; i += 2 * h) {
+                float* lo = a + 2 * i;
+                float* hi = a + 2 * (i + h);
+                for (std::size_t j = 0; j < 2 * h; j += 8) {
+                    const float32x4x2_t u = vld2q_f32(lo + j);
+                    const float32x4x2_t v = NeonMul(vld2q_f32(hi + j), vld2q_f32(w + j));
+                    vst2q_f32(lo + j, NeonAdd(u, v));
+                    vst2q_f32(hi + j, NeonSub(u, v));
+                }
+            }
+        }
+
+        void NeonRadix4(float* a, std::size_t n, std::size_t h, const float* w1, const float* w2) {
+            if (h < 4) {
+                detail::ScalarRadix4(a, n, h, w1, w2);
+                return;
+            }
+            for (std::size_t i = 0; i < n; i += 4 * h) {
+                float* p0 = a + 2 * i;
+                float* p1 = p0 + 2 * h;
+                float* p2 = p0 + 4 * h;
+                float* p3 = p0 + 6 * h;
+                for (std::size_t j = 0; j < 2 * h; j += 8) {
+                    const float32x4x2_t t1 = vld2q_f32(w1 + j);
+                    const float32x4x2_t t2 = vld2q_f32(w2 + j);
+
+                    const float32x4x2_t a0 = vld2q_f32(p0 + j);
+                    const float32x4x2_t x1 = NeonMul(vld2q_f32(p1 + j), t1);
+                    const float32x4x2_t a2 = vld2q_f32(p2 + j);
+                    const float32x4x2_t x3 = NeonMul(vld2q_f32(p3 + j), t1);
+
+                    const float32x4x2_t b0 = NeonAdd(a0, x1);
+                    const float32x4x2_t b1 = NeonSub(a0, x1);
+                    const float32x4x2_t b2 = NeonAdd(a2, x3);
+                    const float32x4x2_t b3 = NeonSub(a2, x3);
+
+                    const float32x4x2_t y2 = NeonMul(b2, t2);
+                    const float32x4x2_t y3 = NeonMul(b3, t2);
+
+                    vst2q_f32(p0 + j, NeonAdd(b0, y2));
+                    vst2q_f32(p2 + j, NeonSub(b0, y2));
+
+                    // b1 +/- (-i)*y3: re = b1.re +/- y3.im, im = b1.im -/+ y3.re
+                    float32x4x2_t c1;
+                    c1.val[0] = vaddq_f32(b1.val[0], y3.val[1]);
+                    c1.val[1] = vsubq_f32(b1.val[1], y3.val[0]);
+                    float32x4x2_t c3;
+                    c3.val[0] = vsubq_f32(b1.val[0], y3.val[1]);
+                    c3.val[1] = vaddq_f32(b1.val[1], y3.val[0]);
+                    vst2q_f32(p1 + j, c1);
+                    vst2q_f32(p3 + j, c3);
+                }
+            }
+        }
+
+        const FftKernels kNeonKernels{
+            .isa = SimdIsa::kNeon,
+            .radix2 = &NeonRadix2,
+            .radix4 = &NeonRadix4,
+        };
+
+    }  // namespace
+#endif
+
+    namespace detail {
+        const FftKernels* NeonFftKernels() {
+#if UAV_FFT_HAVE_NEON
+            return &kNeonKernels;
+#else
+            return nullptr;
+#endif
+        }
+    }  // namespace detail
+
+}  // namespace core::dsp
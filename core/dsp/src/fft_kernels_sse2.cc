@@ -0,0 +1,113 @@
+#include "core/dsp/fft_kernels.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <emmintrin.h>
+#define UAV_FFT_HAVE_SSE2 1
+#else
+#define UAV_FFT_HAVE_SSE2 0
+#endif
+
+namespace core::dsp {
+
+#if UAV_FFT_HAVE_SSE2
+    namespace {
+
+        // 2 complex values per register: [r0, i0, r1, i1]
+
+        inline __m128 Sse2SignOdd() {
+            return _mm_castsi128_ps(_mm_set_epi32(static_cast<int>(0x80000000u), 0, static_cast<int>(0x80000000u), 0));
+        }
+
+        inline __m128 Sse2SignEven() {
+            return _mm_castsi128_ps(_mm_set_epi32(0, static_cast<int>(0x80000000u), 0, static_cast<int>(0x80000000u)));
+        }
+
+        // x * w (complex, lane-wise)
+        inline __m128 Sse2Mul(__m128 x, __m128 w, __m128 sign_even) {
+            const __m128 wr = _mm_shuffle_ps(w, w, _MM_SHUFFLE(2, 2, 0, 0));
+            const __m128 wi = _mm_shuffle_ps(w, w, _MM_SHUFFLE(3, 3, 1, 1));
+            const __m128 xs = _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 3, 0, 1));  // [i0, r0, i1, r1]
+            const __m128 t = _mm_xor_ps(_mm_mul_ps(xs, wi), sign_even);       // [-i*wi, r*wi, ...]
+            return _mm_add_ps(_mm_mul_ps(x, wr), t);
+        }
+
+        // x * (-i) = (im, -re)
+        inline __m128 Sse2MulNegI(__m128 x, __m128 sign_odd) {
+            return _mm_xor_ps(_mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 3, 0, 1)), sign_odd);
+        }
+
+        void Sse2Radix2(float* a, std::size_t n, std::size_t h, const float* w) {
+            if (h < 2) {
+                detail::ScalarRadix2(a, n, h, w);
+                return;
+            }
+            const __m128 sign_even = Sse2SignEven();
+            for (std::size_t i = 0; i < n; i += 2 * h) {
+                float* lo = a + 2 * i;
+                float* hi = a + 2 * (i + h);
+                for (std::size_t j = 0; j < h; j += 2) {
+                    const __m128 u = _mm_loadu_ps(lo + 2 * j);
+                    const __m128 v = Sse2Mul(_mm_loadu_ps(hi + 2 * j), _mm_loadu_ps(w + 2 * j), sign_even);
+                    _mm_storeu_ps(lo + 2 * j, _mm_add_ps(u, v));
+                    _mm_storeu_ps(hi + 2 * j, _mm_sub_ps(u, v));
+                }
+            }
+        }
+
+        void Sse2Radix4(float* a, std::size_t n, std::size_t h, const float* w1, const float* w2) {
+            if (h < 2) {
+                detail::ScalarRadix4(a, n, h, w1, w2);
+                return;
+            }
+            const __m128 sign_even = Sse2SignEven();
+            const __m128 sign_odd = Sse2SignOdd();
+            for (std::size_t i = 0; i < n; i += 4 * h) {
+                float* p0 = a + 2 * i;
+                float* p1 = p0 + 2 * h;
+                float* p2 = p0 + 4 * h;
+                float* p3 = p0 + 6 * h;
+                for (std::size_t j = 0; j < 2 * h; j += 4) {
+                    const __m128 t1 = _mm_loadu_ps(w1 + j);
+                    const __m128 t2 = _mm_loadu_ps(w2 + j);
+
+                    const __m128 a0 = _mm_loadu_ps(p0 + j);
+                    const __m128 x1 = Sse2Mul(_mm_loadu_ps(p1 + j), t1, sign_even);
+                    const __m128 a2 = _mm_loadu_ps(p2 + j);
+                    const __m128 x3 = Sse2Mul(_mm_loadu_ps(p3 + j), t1, sign_even);
+
+                    const __m128 b0 = _mm_add_ps(a0, x1);
+                    const __m128 b1 = _mm_sub_ps(a0, x1);
+                    const __m128 b2 = _mm_add_ps(a2, x3);
+                    const __m128 b3 = _mm_sub_ps(a2, x3);
+
+                    const __m128 y2 = Sse2Mul(b2, t2, sign_even);
+                    const __m128 y3 = Sse2MulNegI(Sse2Mul(b3, t2, sign_even), sign_odd);
+
+                    _mm_storeu_ps(p0 + j, _mm_add_ps(b0, y2));
+                    _mm_storeu_ps(p2 + j, _mm_sub_ps(b0, y2));
+                    _mm_storeu_ps(p1 + j, _mm_add_ps(b1, y3));
+                    _mm_storeu_ps(p3 + j, _mm_sub_ps(b1, y3));
+                }
+            }
+        }
+
+        const FftKernels kSse2Kernels{
+            .isa = SimdIsa::kSse2,
+            .radix2 = &Sse2Radix2,
+            .radix4 = &Sse2Radix4,
+        };
+
+    }  // namespace
+#endif
+
+    namespace detail {
+        const FftKernels* Sse2FftKernels() {
+#if UAV_FFT_HAVE_SSE2
+            return &kSse2Kernels;
+#else
+            return nullptr;
+#endif
+        }
+    }  // namespace detail
+
+}  // namespace core::dsp
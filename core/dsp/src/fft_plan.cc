@@ -0,0 +1,75 @@
+#include "core/dsp/fft_plan.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <numbers>
+#include <utility>
+
+namespace core::dsp {
+
+    FftPlan::FftPlan(int n, const FftKernels* kernels)
+        : n_(static_cast<int>(std::bit_floor(static_cast<unsigned>(std::max(1, n))))),
+        kernels_(kernels ? kernels : &ActiveFftKernels()) {
+        const std::size_t un = static_cast<std::size_t>(n_);
+
+        // Twiddles are evaluated directly in double precision (no w *= wlen recurrence),
+        // so every table entry is correctly rounded regardless of n.
+        twiddles_.resize(un > 1 ? un - 1 : 0);
+        for (std::size_t h = 1; h < un; h <<= 1) {
+            const double step = -std::numbers::pi / static_cast<double>(h);
+            for (std::size_t j = 0; j < h; ++j) {
+                const double ang = step * static_cast<double>(j);
+                twiddles_[h - 1 + j] = std::complex<float>(
+                    static_cast<float>(std::cos(ang)), static_cast<float>(std::sin(ang)));
+            }
+        }
+
+        // Bit-reversal permutation
+        bitrev_.assign(un, 0);
+        for (std::size_t i = 1, j = 0; i < un; ++i) {
+            std::size_t bit = un >> 1;
+            for (; j & bit; bit >>= 1) j ^= bit;
+            j ^= bit;
+            bitrev_[i] = static_cast<std::uint32_t>(j);
+            if (i < j) {
+                swaps_.push_back(static_cast<std::uint32_t>(i));
+                swaps_.push_back(static_cast<std::uint32_t>(j));
+            }
+        }
+
+        scratch_.assign(un, { 0.0f, 0.0f });
+    }
+
+    void FftPlan::Forward(std::complex<float>* data) const {
+        if (n_ <= 1) return;
+        for (std::size_t s = 0; s < swaps_.size(); s += 2) {
+            std::swap(data[swaps_[s]], data[swaps_[s + 1]]);
+        }
+        Butterflies(data);
+    }
+
+    void FftPlan::Forward(const std::complex<float>* in, std::complex<float>* out) const {
+        for (int i = 0; i < n_; ++i) {
+            out[i] = in[bitrev_[static_cast<std::size_t>(i)]];
+        }
+        if (n_ > 1) Butterflies(out);
+    }
+
+    void FftPlan::Butterflies(std::complex<float>* a) const {
+        const std::size_t n = static_cast<std::size_t>(n_);
+        float* f = reinterpret_cast<float*>(a);
+        const float* tw = reinterpret_cast<const float*>(twiddles_.data());
+
+        // Stage with half-size h starts at twiddle index h-1 (2*(h-1) floats).
+        std::size_t h = 1;
+        if (std::countr_zero(n) % 2 != 0) {
+            kernels_->radix2(f, n, h, tw);
+            h = 2;
+        }
+        for (; h < n; h <<= 2) {
+            kernels_->radix4(f, n, h, tw + 2 * (h - 1), tw + 2 * (2 * h - 1));
+        }
+    }
+
+}  // namespace core::dsp
@@ -3,7 +3,6 @@
 
 #include <algorithm>
 #include <cmath>
-#include <cstring>
 
 namespace core::dsp {
 
@@ -21,7 +20,6 @@ namespace core::dsp {
 
     MelFilterbank::MelFilterbank(const MelFilterbankConfig& cfg) : cfg_(cfg) {
         n_freqs_ = cfg_.n_fft / 2 + 1;
-        w_.assign(static_cast<std::size_t>(cfg_.n_mels * n_freqs_), 0.0f);
         Build();
     }
 
@@ -53,7 +51,11 @@ namespace core::dsp {
             bin[static_cast<std::size_t>(i)] = ClampInt(b, 0, n_freqs_ - 1);
         }
 
-        // build triangles
+        // build triangles (one dense row at a time), keep only the nonzero span
+        bands_.assign(static_cast<std::size_t>(cfg_.n_mels), Band{});
+        weights_.clear();
+        std::vector<float> row(static_cast<std::size_t>(n_freqs_), 0.0f);
+
         for (int m = 0; m < cfg_.n_mels; ++m) {
             const int left = bin[static_cast<std::size_t>(m)];
             const int center = bin[static_cast<std::size_t>(m + 1)];
@@ -61,31 +63,84 @@ namespace core::dsp {
 
             if (right <= left) continue;
 
+            std::fill(row.begin() + left, row.begin() + right + 1, 0.0f);
+
             // rising
             for (int k = left; k < center; ++k) {
                 const float denom = static_cast<float>(center - left);
                 const float val = (denom > 0.0f) ? (static_cast<float>(k - left) / denom) : 0.0f;
-                w_[static_cast<std::size_t>(m * n_freqs_ + k)] = val;
+                row[static_cast<std::size_t>(k)] = val;
             }
             // falling
             for (int k = center; k <= right; ++k) {
                 const float denom = static_cast<float>(right - center);
                 const float val = (denom > 0.0f) ? (static_cast<float>(right - k) / denom) : 0.0f;
-                w_[static_cast<std::size_t>(m * n_freqs_ + k)] =
-                    std::max(w_[static_cast<std::size_t>(m * n_freqs_ + k)], val);
+                row[static_cast<std::size_t>(k)] = std::max(row[static_cast<std::size_t>(k)], val);
             }
+
+            int first = left;
+            int last = right;
+            while (first <= last && row[static_cast<std::size_t>(first)] == 0.0f) ++first;
+            while (last >= first && row[static_cast<std::size_t>(last)] == 0.0f) --last;
+            if (first > last) continue;
+
+            Band& b = bands_[static_cast<std::size_t>(m)];
+            b.start = first;
+            b.length = last - first + 1;
+            b.offset = static_cast<int>(weights_.size());
+            weights_.insert(weights_.end(), row.begin() + first, row.begin() + last + 1);
         }
     }
 
     void MelFilterbank::Apply(const float* power, float* out_mel) const {
-        std::memset(out_mel, 0, static_cast<std::size_t>(cfg_.n_mels) * sizeof(float));
         for (int m = 0; m < cfg_.n_mels; ++m) {
-            float acc = 0.0f;
-            const float* row = &w_[static_cast<std::size_t>(m * n_freqs_)];
-            for (int k = 0; k < n_freqs_; ++k) {
-                acc += row[k] * power[k];
+            const Band& b = bands_[static_cast<std::size_t>(m)];
+            const float* w = weights_.data() + b.offset;
+            const float* p = power + b.start;
+
+            // 4 independent accumulators: no serial add chain, maps onto one SIMD register
+            float acc0 = 0.0f, acc1 = 0.0f, acc2 = 0.0f, acc3 = 0.0f;
+            int k = 0;
+            for (; k + 4 <= b.length; k += 4) {
+                acc0 += w[k] * p[k];
+                acc1 += w[k + 1] * p[k + 1];
+                acc2 += w[k + 2] * p[k + 2];
+                acc3 += w[k + 3] * p[k + 3];
+            }
+            for (; k < b.length; ++k) {
+                acc0 += w[k] * p[k];
+            }
+            out_mel[m] = (acc0 + acc1) + (acc2 + acc3);
+        }
+    }
+
+    void MelFilterbank::ApplyBatch(const float* power, int n_frames, float* out_mel) const {
+        if (n_frames == 1) {
+            Apply(power, out_mel);
+            return;
+        }
+        const int n_mels = cfg_.n_mels;
+        for (int m = 0; m < n_mels; ++m) {
+            const Band& b = bands_[static_cast<std::size_t>(m)];
+            const float* w = weights_.data() + b.offset;
+
+            for (int f = 0; f < n_frames; ++f) {
+                const float* p = power + static_cast<std::size_t>(f) * static_cast<std::size_t>(n_freqs_) + b.start;
+
+                // same summation order as Apply(): batched and per-frame output are identical
+                float acc0 = 0.0f, acc1 = 0.0f, acc2 = 0.0f, acc3 = 0.0f;
+                int k = 0;
+                for (; k + 4 <= b.length; k += 4) {
+                    acc0 += w[k] * p[k];
+                    acc1 += w[k + 1] * p[k + 1];
+                    acc2 += w[k + 2] * p[k + 2];
+                    acc3 += w[k + 3] * p[k + 3];
+                }
+                for (; k < b.length; ++k) {
+                    acc0 += w[k] * p[k];
+                }
+                out_mel[static_cast<std::size_t>(f) * static_cast<std::size_t>(n_mels) + m] = (acc0 + acc1) + (acc2 + acc3);
             }
-            out_mel[m] = acc;
         }
     }
 
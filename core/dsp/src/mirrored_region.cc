@@ -0,0 +1,102 @@
+#include "core/dsp/mirrored_region.h"
+
+#include <iostream>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace core::dsp {
+
+    MirroredRegion::~MirroredRegion() { Release(); }
+
+    MirroredRegion::MirroredRegion(MirroredRegion&& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+    }
+
+    MirroredRegion& MirroredRegion::operator=(MirroredRegion&& other) noexcept {
+        if (this != &other) {
+            Release();
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+        }
+        return *this;
+    }
+
+#if defined(__linux__)
+
+    bool MirroredRegion::Supported() { return true; }
+
+    std::size_t MirroredRegion::PageSize() {
+        const long ps = sysconf(_SC_PAGESIZE);
+        return ps > 0 ? static_cast<std::size_t>(ps) : 4096;
+    }
+
+    bool MirroredRegion::Allocate(std::size_t size) {
+        Release();
+        if (size == 0 || size % PageSize() != 0) {
+            std::cerr << "[MirroredRegion] size " << size << " is not a positive multiple of the page size\n";
+            return false;
+        }
+
+        const int fd = memfd_create("uav_mirrored_region", MFD_CLOEXEC);
+        if (fd < 0) {
+            std::cerr << "[MirroredRegion] memfd_create failed\n";
+            return false;
+        }
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            std::cerr << "[MirroredRegion] ftruncate failed\n";
+            close(fd);
+            return false;
+        }
+
+        // Reserve 2*size of address space, then map the same pages into both halves
+        void* base = mmap(nullptr, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base == MAP_FAILED) {
+            std::cerr << "[MirroredRegion] address reservation failed\n";
+            close(fd);
+            return false;
+        }
+        auto* lo = static_cast<unsigned char*>(base);
+        void* a = mmap(lo, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+        void* b = mmap(lo + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+        close(fd);  // the mappings keep the memory alive
+        if (a == MAP_FAILED || b == MAP_FAILED) {
+            std::cerr << "[MirroredRegion] mirror mapping failed\n";
+            munmap(base, 2 * size);
+            return false;
+        }
+
+        data_ = base;
+        size_ = size;
+        return true;
+    }
+
+    void MirroredRegion::Release() {
+        if (data_) munmap(data_, 2 * size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+#else
+
+    bool MirroredRegion::Supported() { return false; }
+
+    std::size_t MirroredRegion::PageSize() { return 4096; }
+
+    bool MirroredRegion::Allocate(std::size_t /*size*/) {
+        Release();
+        return false;
+    }
+
+    void MirroredRegion::Release() {
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+#endif
+
+}  // namespace core::dsp
@@ -1,7 +1,8 @@
 #include "core/dsp/pcen_extractor.h"
-#include "core/dsp/fft_radix2.h"
+#include "core/dsp/fft_radix2.h"  // kPi
 
 #include <algorithm>
+#include <bit>
 #include <cmath>
 #include <cstring>
 
@@ -15,18 +16,40 @@ namespace core::dsp {
             .n_mels = cfg.n_mels,
             .f_min = cfg.f_min,
             .f_max = cfg.f_max,
-            }) {
-        in_fifo_.clear();
+            }),
+        rfft_(cfg.n_fft),
+        cfft_(cfg.real_fft ? 1 : cfg.n_fft),
+        pcen_kernel_(cfg) {
         window_.assign(static_cast<std::size_t>(cfg_.win_length), 0.0f);
-        fft_buf_.assign(static_cast<std::size_t>(cfg_.n_fft), { 0.0f, 0.0f });
-        power_.assign(static_cast<std::size_t>(cfg_.n_fft / 2 + 1), 0.0f);
-        mel_energy_.assign(static_cast<std::size_t>(cfg_.n_mels), 0.0f);
+        fft_in_.assign(static_cast<std::size_t>(cfg_.n_fft), 0.0f);
+        if (cfg_.real_fft) {
+            fft_buf_.assign(static_cast<std::size_t>(cfg_.n_fft / 2 + 1), { 0.0f, 0.0f });
+        }
+        else {
+            fft_buf_.assign(static_cast<std::size_t>(cfg_.n_fft), { 0.0f, 0.0f });
+        }
+        hop_ = std::max(1, cfg_.hop_length);
+        batch_ = std::max(1, cfg_.max_batch_frames);
+
+        // Room for one full batch of windows
+        const std::size_t need = static_cast<std::size_t>(cfg_.win_length) +
+            static_cast<std::size_t>(batch_ - 1) * static_cast<std::size_t>(hop_);
+        ring_.assign(std::bit_ceil(need), 0.0f);
+        ring_mask_ = ring_.size() - 1;
+        power_.assign(static_cast<std::size_t>(batch_) * static_cast<std::size_t>(cfg_.n_fft / 2 + 1), 0.0f);
+        mel_energy_.assign(static_cast<std::size_t>(batch_) * static_cast<std::size_t>(cfg_.n_mels), 0.0f);
         pcen_m_.assign(static_cast<std::size_t>(cfg_.n_mels), 0.0f);
-        pcen_frame_.assign(static_cast<std::size_t>(cfg_.n_mels), 0.0f);
+        pcen_m_batch_.assign(static_cast<std::size_t>(batch_) * static_cast<std::size_t>(cfg_.n_mels), 0.0f);
 
         ComputeHann();
     }
 
+    void PcenExtractor::Reset() {
+        written_ = 0;
+        next_start_ = 0;
+        std::fill(pcen_m_.begin(), pcen_m_.end(), 0.0f);
+    }
+
     void PcenExtractor::ComputeHann() {
         // Hann on win_length, later placed in n_fft with zero-padding.
         for (int i = 0; i < cfg_.win_length; ++i) {
@@ -35,16 +58,37 @@ namespace core::dsp {
         }
     }
 
-    void PcenExtractor::OneFrame(const float* frame_win, float* out_pcen) {
-        // Build FFT input
-        std::fill(fft_buf_.begin(), fft_buf_.end(), std::complex<float>(0.0f, 0.0f));
-        for (int i = 0; i < cfg_.win_length; ++i) {
-            const float v = frame_win[i] * window_[static_cast<std::size_t>(i)];
-            fft_buf_[static_cast<std::size_t>(i)] = std::complex<float>(v, 0.0f);
+    void PcenExtractor::LoadFrame(std::int64_t start) {
+        // Window [start, start + win_length) may wrap around the end of the ring
+        const std::size_t pos = static_cast<std::size_t>(start) & ring_mask_;
+        const int n1 = static_cast<int>(std::min<std::size_t>(static_cast<std::size_t>(cfg_.win_length), ring_.size() - pos));
+        const float* a = ring_.data() + pos;
+        for (int i = 0; i < n1; ++i) {
+            fft_in_[static_cast<std::size_t>(i)] = a[i] * window_[static_cast<std::size_t>(i)];
+        }
+        const float* b = ring_.data();
+        for (int i = n1; i < cfg_.win_length; ++i) {
+            fft_in_[static_cast<std::size_t>(i)] = b[i - n1] * window_[static_cast<std::size_t>(i)];
         }
+    }
 
-        // FFT in-place
-        FftRadix2(fft_buf_);
+    void PcenExtractor::Spectrum(std::int64_t start, float* out_power) {
+        // Windowed frame into fft_in_[0..win_length) (tail stays zero-padded)
+        LoadFrame(start);
+
+        if (cfg_.real_fft) {
+            // One-sided spectrum straight into fft_buf_[0..n_fft/2]
+            rfft_.Forward(fft_in_.data(), fft_buf_.data());
+        }
+        else {
+            // Build FFT input
+            for (int i = 0; i < cfg_.n_fft; ++i) {
+                fft_buf_[static_cast<std::size_t>(i)] = std::complex<float>(fft_in_[static_cast<std::size_t>(i)], 0.0f);
+            }
+
+            // FFT in-place
+            cfft_.Forward(fft_buf_.data());
+        }
 
         // Power spectrum (one-sided)
         const int n_freqs = cfg_.n_fft / 2 + 1;
@@ -52,48 +96,103 @@ namespace core::dsp {
         for (int k = 0; k < n_freqs; ++k) {
             const auto c = fft_buf_[static_cast<std::size_t>(k)] * inv_n;
             const float p = (c.real() * c.real() + c.imag() * c.imag());
-            power_[static_cast<std::size_t>(k)] = std::max(cfg_.floor, p);
+            out_power[k] = std::max(cfg_.floor, p);
         }
+    }
 
-        // Mel energies
-        mel_.Apply(power_.data(), mel_energy_.data());
-
-        // PCEN smoothing + compression
-        const float delta_r = std::pow(cfg_.delta, cfg_.r);
-        for (int m = 0; m < cfg_.n_mels; ++m) {
-            const float E = std::max(cfg_.floor, mel_energy_[static_cast<std::size_t>(m)]);
-            float& M = pcen_m_[static_cast<std::size_t>(m)];
-            M = (1.0f - cfg_.s) * M + cfg_.s * E;
+    int PcenExtractor::PcenBatch(int n_frames, IPcenFrameSink* sink) {
+        const int mels = cfg_.n_mels;
+
+        // Smoothing is a recursion over time: run it frame after frame, keep every M.
+        for (int f = 0; f < n_frames; ++f) {
+            const float* E = &mel_energy_[static_cast<std::size_t>(f * mels)];
+            float* M_out = &pcen_m_batch_[static_cast<std::size_t>(f * mels)];
+            for (int m = 0; m < mels; ++m) {
+                float& M = pcen_m_[static_cast<std::size_t>(m)];
+                M = (1.0f - cfg_.s) * M + cfg_.s * std::max(cfg_.floor, E[m]);
+                M_out[m] = M;
+            }
+        }
 
-            const float denom = std::pow(cfg_.eps + M, cfg_.alpha);
-            const float x = (E / denom) + cfg_.delta;
-            out_pcen[m] = std::pow(x, cfg_.r) - delta_r;
+        // Compression has no cross-frame dependency: each frame goes straight into sink storage.
+        int delivered = 0;
+        for (int f = 0; f < n_frames; ++f) {
+            float* dst = sink->AcquireFrame();
+            if (!dst) continue;  // sink full: drop (smoother state is already updated)
+            const std::size_t off = static_cast<std::size_t>(f * mels);
+            pcen_kernel_.Compress(&mel_energy_[off], &pcen_m_batch_[off], dst, static_cast<std::size_t>(mels));
+            sink->CommitFrame(FrameTimeNs(next_start_ + static_cast<std::int64_t>(f) * hop_));
+            ++delivered;
         }
+        return delivered;
     }
 
     int PcenExtractor::Process(const float* mono, int n, std::vector<float>* out_frames) {
         if (!out_frames) return 0;
+        VectorFrameSink sink(out_frames, cfg_.n_mels);
+        return Process(mono, n, &sink);
+    }
+
+    std::int64_t PcenExtractor::FrameTimeNs(std::int64_t start) const {
+        return t0_ns_ + (start - t0_sample_) * 1'000'000'000LL / std::max(1, cfg_.sample_rate);
+    }
 
-        // Append to fifo
-        const std::size_t old = in_fifo_.size();
-        in_fifo_.resize(old + static_cast<std::size_t>(n));
-        std::memcpy(in_fifo_.data() + old, mono, static_cast<std::size_t>(n) * sizeof(float));
+    int PcenExtractor::Process(const float* mono, int n, IPcenFrameSink* sink, std::int64_t t0_ns) {
+        if (!sink) return 0;
+        t0_ns_ = t0_ns;
+        t0_sample_ = written_;
 
+        const int n_freqs = cfg_.n_fft / 2 + 1;
+        const std::int64_t cap = static_cast<std::int64_t>(ring_.size());
+        int left = std::max(0, n);
         int produced = 0;
 
-        // While we can take a window
-        while (static_cast<int>(in_fifo_.size()) >= cfg_.win_length) {
-            OneFrame(in_fifo_.data(), pcen_frame_.data());
-            out_frames->insert(out_frames->end(), pcen_frame_.begin(), pcen_frame_.end());
-            produced++;
+        for (;;) {
+            // hop > win_length: samples between windows are never needed
+            if (written_ < next_start_ && left > 0) {
+                const int skip = static_cast<int>(std::min<std::int64_t>(left, next_start_ - written_));
+                mono += skip;
+                left -= skip;
+                written_ += skip;
+            }
+
+            // Append as much as fits behind the oldest sample still needed
+            const std::int64_t used = std::max<std::int64_t>(0, written_ - next_start_);
+            const int take = static_cast<int>(std::min<std::int64_t>(left, cap - used));
+            if (take > 0) {
+                const std::size_t pos = static_cast<std::size_t>(written_) & ring_mask_;
+                const std::size_t n1 = std::min(static_cast<std::size_t>(take), ring_.size() - pos);
+                std::memcpy(ring_.data() + pos, mono, n1 * sizeof(float));
+                std::memcpy(ring_.data(), mono + n1, (static_cast<std::size_t>(take) - n1) * sizeof(float));
+                mono += take;
+                left -= take;
+                written_ += take;
+            }
 
-            // Pop hop_length
-            if (cfg_.hop_length <= 0) break;
-            if (static_cast<int>(in_fifo_.size()) <= cfg_.hop_length) {
-                in_fifo_.clear();
+            const std::int64_t avail = written_ - next_start_;
+            if (avail < cfg_.win_length) {
+                if (left > 0) continue;
                 break;
             }
-            in_fifo_.erase(in_fifo_.begin(), in_fifo_.begin() + cfg_.hop_length);
+
+            // Frames whose window is in the ring, capped by the batch size
+            const int ready = 1 + static_cast<int>((avail - cfg_.win_length) / hop_);
+            const int k = std::min(ready, batch_);
+
+            // Stage 1: window + FFT + power for k frames
+            for (int f = 0; f < k; ++f) {
+                Spectrum(next_start_ + static_cast<std::int64_t>(f) * hop_,
+                    &power_[static_cast<std::size_t>(f * n_freqs)]);
+            }
+
+            // Stage 2: mel projection [k][n_freqs] -> [k][n_mels]
+            mel_.ApplyBatch(power_.data(), k, mel_energy_.data());
+
+            // Stage 3: PCEN straight into the sink
+            produced += PcenBatch(k, sink);
+
+            // Advance k hops (just a counter)
+            next_start_ += static_cast<std::int64_t>(k) * hop_;
         }
 
         return produced;
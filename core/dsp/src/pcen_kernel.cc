@@ -0,0 +1,358 @@
+#include "core/dsp/pcen_kernel.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <emmintrin.h>
+#define UAV_PCEN_SSE2 1
+#else
+#define UAV_PCEN_SSE2 0
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define UAV_PCEN_NEON 1
+#else
+#define UAV_PCEN_NEON 0
+#endif
+
+namespace core::dsp {
+
+    namespace {
+
+        // Cephes single-precision logf/expf polynomials (as in the usual sse/neon_mathfun ports):
+        // ~1-2 ulp each over the ranges PCEN uses.
+        constexpr float kExpHi = 88.3762626647949f;
+        constexpr float kExpLo = -88.3762626647949f;
+        constexpr float kLog2e = 1.44269504088896341f;
+        constexpr float kExpC1 = 0.693359375f;
+        constexpr float kExpC2 = -2.12194440e-4f;
+        constexpr float kExpP0 = 1.9875691500e-4f;
+        constexpr float kExpP1 = 1.3981999507e-3f;
+        constexpr float kExpP2 = 8.3334519073e-3f;
+        constexpr float kExpP3 = 4.1665795894e-2f;
+        constexpr float kExpP4 = 1.6666665459e-1f;
+        constexpr float kExpP5 = 5.0000001201e-1f;
+
+        constexpr float kSqrtHalf = 0.707106781186547524f;
+        constexpr float kLogP0 = 7.0376836292e-2f;
+        constexpr float kLogP1 = -1.1514610310e-1f;
+        constexpr float kLogP2 = 1.1676998740e-1f;
+        constexpr float kLogP3 = -1.2420140846e-1f;
+        constexpr float kLogP4 = 1.4249322787e-1f;
+        constexpr float kLogP5 = -1.6668057665e-1f;
+        constexpr float kLogP6 = 2.0000714765e-1f;
+        constexpr float kLogP7 = -2.4999993993e-1f;
+        constexpr float kLogP8 = 3.3333331174e-1f;
+        constexpr float kLogQ1 = -2.12194440e-4f;
+        constexpr float kLogQ2 = 0.693359375f;
+
+        // ---- scalar (tails and non-SIMD targets) ----
+
+        inline float PcenLog(float x) {
+            x = std::max(x, std::numeric_limits<float>::min());
+            std::uint32_t bits = std::bit_cast<std::uint32_t>(x);
+            float e = static_cast<float>(static_cast<int>(bits >> 23) - 126);
+            bits = (bits & 0x807fffffu) | 0x3f000000u;  // mantissa in [0.5, 1)
+            float m = std::bit_cast<float>(bits);
+            if (m < kSqrtHalf) {
+                e -= 1.0f;
+                m = m + m - 1.0f;
+            }
+            else {
+                m = m - 1.0f;
+            }
+            const float z = m * m;
+            float y = kLogP0;
+            y = y * m + kLogP1;
+            y = y * m + kLogP2;
+            y = y * m + kLogP3;
+            y = y * m + kLogP4;
+            y = y * m + kLogP5;
+            y = y * m + kLogP6;
+            y = y * m + kLogP7;
+            y = y * m + kLogP8;
+            y = y * m * z;
+            y += e * kLogQ1;
+            y -= 0.5f * z;
+            return m + y + e * kLogQ2;
+        }
+
+        inline float PcenExp(float x) {
+            x = std::clamp(x, kExpLo, kExpHi);
+            const float fx = std::floor(x * kLog2e + 0.5f);
+            x -= fx * kExpC1;
+            x -= fx * kExpC2;
+            const float z = x * x;
+            float y = kExpP0;
+            y = y * x + kExpP1;
+            y = y * x + kExpP2;
+            y = y * x + kExpP3;
+            y = y * x + kExpP4;
+            y = y * x + kExpP5;
+            y = y * z + x + 1.0f;
+            const std::uint32_t pow2n = static_cast<std::uint32_t>(static_cast<int>(fx) + 127) << 23;
+            return y * std::bit_cast<float>(pow2n);
+        }
+
+#if UAV_PCEN_SSE2
+        inline __m128 PcenLogSse2(__m128 x) {
+            const __m128 one = _mm_set1_ps(1.0f);
+            x = _mm_max_ps(x, _mm_set1_ps(std::numeric_limits<float>::min()));
+
+            __m128i emm0 = _mm_srli_epi32(_mm_castps_si128(x), 23);
+            x = _mm_and_ps(x, _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x807fffffu))));
+            x = _mm_or_ps(x, _mm_set1_ps(0.5f));
+
+            emm0 = _mm_sub_epi32(emm0, _mm_set1_epi32(0x7f));
+            __m128 e = _mm_add_ps(_mm_cvtepi32_ps(emm0), one);
+
+            const __m128 mask = _mm_cmplt_ps(x, _mm_set1_ps(kSqrtHalf));
+            const __m128 tmp = _mm_and_ps(x, mask);
+            x = _mm_sub_ps(x, one);
+            e = _mm_sub_ps(e, _mm_and_ps(one, mask));
+            x = _mm_add_ps(x, tmp);
+
+            const __m128 z = _mm_mul_ps(x, x);
+            __m128 y = _mm_set1_ps(kLogP0);
+            y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(kLogP1));
+            y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(kLogP2));
+            y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(kLogP3));
+            y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(kLogP4));
+            y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(kLogP5));
+            y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(kLogP6));
+            y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(kLogP7));
+            y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(kLogP8));
+            y = _mm_mul_ps(_mm_mul_ps(y, x), z);
+
+            y = _mm_add_ps(y, _mm_mul_ps(e, _mm_set1_ps(kLogQ1)));
+            y = _mm_sub_ps(y, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+            x = _mm_add_ps(x, y);
+            return _mm_add_ps(x, _mm_mul_ps(e, _mm_set1_ps(kLogQ2)));
+        }
+
+        inline __m128 PcenExpSse2(__m128 x) {
+            const __m128 one = _mm_set1_ps(1.0f);
+            x = _mm_min_ps(x, _mm_set1_ps(kExpHi));
+            x = _mm_max_ps(x, _mm_set1_ps(kExpLo));
+
+            // fx = floor(x * log2(e) + 0.5)
+            __m128 fx = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(kLog2e)), _mm_set1_ps(0.5f));
+            const __m128 tmp = _mm_cvtepi32_ps(_mm_cvttps_epi32(fx));
+            fx = _mm_sub_ps(tmp, _mm_and_ps(_mm_cmpgt_ps(tmp, fx), one));
+
+            x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(kExpC1)));
+            x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(kExpC2)));
+
+            const __m128 z = _mm_mul_ps(x, x);
+            __m128 y = _mm_set1_ps(kExpP0);
+            y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(kExpP1));
+            y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(kExpP2));
+            y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(kExpP3));
+            y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(kExpP4));
+            y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(kExpP5));
+            y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(y, z), x), one);
+
+            __m128i emm0 = _mm_add_epi32(_mm_cvttps_epi32(fx), _mm_set1_epi32(0x7f));
+            emm0 = _mm_slli_epi32(emm0, 23);
+            return _mm_mul_ps(y, _mm_castsi128_ps(emm0));
+        }
+#endif
+
+#if UAV_PCEN_NEON
+        inline float32x4_t PcenLogNeon(float32x4_t x) {
+            const float32x4_t one = vdupq_n_f32(1.0f);
+            x = vmaxq_f32(x, vdupq_n_f32(std::numeric_limits<float>::min()));
+
+            int32x4_t ux = vreinterpretq_s32_f32(x);
+            const int32x4_t emm0 = vsubq_s32(vshrq_n_s32(ux, 23), vdupq_n_s32(0x7f));
+            ux = vandq_s32(ux, vdupq_n_s32(static_cast<int>(0x807fffffu)));
+            ux = vorrq_s32(ux, vreinterpretq_s32_f32(vdupq_n_f32(0.5f)));
+            x = vreinterpretq_f32_s32(ux);
+
+            float32x4_t e = vaddq_f32(vcvtq_f32_s32(emm0), one);
+
+            const uint32x4_t mask = vcltq_f32(x, vdupq_n_f32(kSqrtHalf));
+            const float32x4_t tmp = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(x), mask));
+            x = vsubq_f32(x, one);
+            e = vsubq_f32(e, vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(one), mask)));
+            x = vaddq_f32(x, tmp);
+
+            const float32x4_t z = vmulq_f32(x, x);
+            float32x4_t y = vdupq_n_f32(kLogP0);
+            y = vfmaq_f32(vdupq_n_f32(kLogP1), y, x);
+            y = vfmaq_f32(vdupq_n_f32(kLogP2), y, x);
+            y = vfmaq_f32(vdupq_n_f32(kLogP3), y, x);
+            y = vfmaq_f32(vdupq_n_f32(kLogP4), y, x);
+            y = vfmaq_f32(vdupq_n_f32(kLogP5), y, x);
+            y = vfmaq_f32(vdupq_n_f32(kLogP6), y, x);
+            y = vfmaq_f32(vdupq_n_f32(kLogP7), y, x);
+            y = vfmaq_f32(vdupq_n_f32(kLogP8), y, x);
+            y = vmulq_f32(vmulq_f32(y, x), z);
+
+            y = vfmaq_f32(y, e, vdupq_n_f32(kLogQ1));
+            y = vfmsq_f32(y, z, vdupq_n_f32(0.5f));
+            x = vaddq_f32(x, y);
+            return vfmaq_f32(x, e, vdupq_n_f32(kLogQ2));
+        }
+
+        inline float32x4_t PcenExpNeon(float32x4_t x) {
+            const float32x4_t one = vdupq_n_f32(1.0f);
+            x = vminq_f32(x, vdupq_n_f32(kExpHi));
+            x = vmaxq_f32(x, vdupq_n_f32(kExpLo));
+
+            const float32x4_t fx = vrndmq_f32(vfmaq_f32(vdupq_n_f32(0.5f), x, vdupq_n_f32(kLog2e)));
+            x = vfmsq_f32(x, fx, vdupq_n_f32(kExpC1));
+            x = vfmsq_f32(x, fx, vdupq_n_f32(kExpC2));
+
+            const float32x4_t z = vmulq_f32(x, x);
+            float32x4_t y = vdupq_n_f32(kExpP0);
+            y = vfmaq_f32(vdupq_n_f32(kExpP1), y, x);
+            y = vfmaq_f32(vdupq_n_f32(kExpP2), y, x);
+            y = vfmaq_f32(vdupq_n_f32(kExpP3), y, x);
+            y = vfmaq_f32(vdupq_n_f32(kExpP4), y, x);
+            y = vfmaq_f32(vdupq_n_f32(kExpP5), y, x);
+            y = vaddq_f32(vfmaq_f32(x, y, z), one);
+
+            int32x4_t mm = vaddq_s32(vcvtq_s32_f32(fx), vdupq_n_s32(0x7f));
+            mm = vshlq_n_s32(mm, 23);
+            return vmulq_f32(y, vreinterpretq_f32_s32(mm));
+        }
+#endif
+
+    }  // namespace
+
+    PcenKernel::PcenKernel(const PcenConfig& cfg)
+        : fast_(cfg.fast_pcen),
+        eps_(cfg.eps),
+        alpha_(cfg.alpha),
+        neg_alpha_(-cfg.alpha),
+        delta_(cfg.delta),
+        r_(cfg.r),
+        delta_r_(std::pow(cfg.delta, cfg.r)),
+        floor_(cfg.floor) {
+        if (alpha_ == 1.0f) alpha_path_ = AlphaPath::kOne;
+        else if (alpha_ == 0.5f) alpha_path_ = AlphaPath::kHalf;
+
+        if (r_ == 1.0f) r_path_ = RPath::kOne;
+        else if (r_ == 0.5f) r_path_ = RPath::kHalf;
+        else if (r_ == 0.25f) r_path_ = RPath::kQuarter;
+    }
+
+    void PcenKernel::CompressReference(const float* E, const float* M, float* out, std::size_t count) const {
+        for (std::size_t i = 0; i < count; ++i) {
+            const float e = std::max(floor_, E[i]);
+            const float denom = std::pow(eps_ + M[i], alpha_);
+            const float x = (e / denom) + delta_;
+            out[i] = std::pow(x, r_) - delta_r_;
+        }
+    }
+
+    void PcenKernel::Compress(const float* E, const float* M, float* out, std::size_t count) const {
+        if (!fast_) {
+            CompressReference(E, M, out, count);
+            return;
+        }
+
+        std::size_t i = 0;
+
+#if UAV_PCEN_SSE2
+        {
+            const __m128 v_floor = _mm_set1_ps(floor_);
+            const __m128 v_eps = _mm_set1_ps(eps_);
+            const __m128 v_neg_alpha = _mm_set1_ps(neg_alpha_);
+            const __m128 v_delta = _mm_set1_ps(delta_);
+            const __m128 v_r = _mm_set1_ps(r_);
+            const __m128 v_delta_r = _mm_set1_ps(delta_r_);
+            const __m128 one = _mm_set1_ps(1.0f);
+
+            for (; i + 4 <= count; i += 4) {
+                const __m128 e = _mm_max_ps(v_floor, _mm_loadu_ps(E + i));
+                const __m128 d = _mm_add_ps(v_eps, _mm_loadu_ps(M + i));
+
+                __m128 inv;  // (eps + M)^-alpha
+                switch (alpha_path_) {
+                case AlphaPath::kOne: inv = _mm_div_ps(one, d); break;
+                case AlphaPath::kHalf: inv = _mm_div_ps(one, _mm_sqrt_ps(d)); break;
+                default: inv = PcenExpSse2(_mm_mul_ps(v_neg_alpha, PcenLogSse2(d))); break;
+                }
+
+                const __m128 x = _mm_add_ps(_mm_mul_ps(e, inv), v_delta);
+
+                __m128 y;  // x^r
+                switch (r_path_) {
+                case RPath::kOne: y = x; break;
+                case RPath::kHalf: y = _mm_sqrt_ps(x); break;
+                case RPath::kQuarter: y = _mm_sqrt_ps(_mm_sqrt_ps(x)); break;
+                default: y = PcenExpSse2(_mm_mul_ps(v_r, PcenLogSse2(x))); break;
+                }
+
+                _mm_storeu_ps(out + i, _mm_sub_ps(y, v_delta_r));
+            }
+        }
+#elif UAV_PCEN_NEON
+        {
+            const float32x4_t v_floor = vdupq_n_f32(floor_);
+            const float32x4_t v_eps = vdupq_n_f32(eps_);
+            const float32x4_t v_neg_alpha = vdupq_n_f32(neg_alpha_);
+            const float32x4_t v_delta = vdupq_n_f32(delta_);
+            const float32x4_t v_r = vdupq_n_f32(r_);
+            const float32x4_t v_delta_r = vdupq_n_f32(delta_r_);
+            const float32x4_t one = vdupq_n_f32(1.0f);
+
+            for (; i + 4 <= count; i += 4) {
+                const float32x4_t e = vmaxq_f32(v_floor, vld1q_f32(E + i));
+                const float32x4_t d = vaddq_f32(v_eps, vld1q_f32(M + i));
+
+                float32x4_t inv;  // (eps + M)^-alpha
+                switch (alpha_path_) {
+                case AlphaPath::kOne: inv = vdivq_f32(one, d); break;
+                case AlphaPath::kHalf: inv = vdivq_f32(one, vsqrtq_f32(d)); break;
+                default: inv = PcenExpNeon(vmulq_f32(v_neg_alpha, PcenLogNeon(d))); break;
+                }
+
+                const float32x4_t x = vfmaq_f32(v_delta, e, inv);
+
+                float32x4_t y;  // x^r
+                switch (r_path_) {
+                case RPath::kOne: y = x; break;
+                case RPath::kHalf: y = vsqrtq_f32(x); break;
+                case RPath::kQuarter: y = vsqrtq_f32(vsqrtq_f32(x)); break;
+                default: y = PcenExpNeon(vmulq_f32(v_r, PcenLogNeon(x))); break;
+                }
+
+                vst1q_f32(out + i, vsubq_f32(y, v_delta_r));
+            }
+        }
+#endif
+
+        for (; i < count; ++i) {
+            const float e = std::max(floor_, E[i]);
+            const float d = eps_ + M[i];
+
+            float inv;
+            switch (alpha_path_) {
+            case AlphaPath::kOne: inv = 1.0f / d; break;
+            case AlphaPath::kHalf: inv = 1.0f / std::sqrt(d); break;
+            default: inv = PcenExp(neg_alpha_ * PcenLog(d)); break;
+            }
+
+            const float x = e * inv + delta_;
+
+            float y;
+            switch (r_path_) {
+            case RPath::kOne: y = x; break;
+            case RPath::kHalf: y = std::sqrt(x); break;
+            case RPath::kQuarter: y = std::sqrt(std::sqrt(x)); break;
+            default: y = PcenExp(r_ * PcenLog(x)); break;
+            }
+
+            out[i] = y - delta_r_;
+        }
+    }
+
+}  // namespace core::dsp
@@ -2,48 +2,198 @@
 
 #include <algorithm>
 #include <cstring>
+#include <iostream>
 
 namespace core::dsp {
 
-    PcenRingBuffer::PcenRingBuffer(int n_mels, int capacity_frames)
-        : n_mels_(n_mels),
-        capacity_frames_(capacity_frames),
-        data_(static_cast<std::size_t>(n_mels)* static_cast<std::size_t>(capacity_frames), 0.0f) {
+    PcenRingBuffer::PcenRingBuffer(int n_mels, int capacity_frames, bool mirrored)
+        : n_mels_(std::max(0, n_mels)),
+        capacity_frames_(std::max(0, capacity_frames)),
+        slots_(capacity_frames_) {
+        const std::size_t frame_bytes = static_cast<std::size_t>(n_mels_) * sizeof(float);
+
+        if (mirrored && frame_bytes > 0 && slots_ > 0) {
+            // Smallest slot count >= capacity whose byte size is a whole number of pages
+            const std::size_t page = MirroredRegion::PageSize();
+            std::size_t slots = static_cast<std::size_t>(slots_);
+            while ((slots * frame_bytes) % page != 0) ++slots;
+
+            if (mirror_.Allocate(slots * frame_bytes)) {
+                slots_ = static_cast<int>(slots);
+                data_ = static_cast<float*>(mirror_.data());
+            }
+            else {
+                std::cerr << "[PcenRingBuffer] mirrored backing unavailable, using heap buffer\n";
+            }
+        }
+        if (!data_) {
+            heap_.assign(static_cast<std::size_t>(n_mels_) * static_cast<std::size_t>(slots_), 0.0f);
+            data_ = heap_.data();
+        }
+
+        seq_ = std::make_unique<std::atomic<std::uint64_t>[]>(static_cast<std::size_t>(slots_));
+        t_ns_ = std::make_unique<std::int64_t[]>(static_cast<std::size_t>(slots_));
+        for (int i = 0; i < slots_; ++i) {
+            seq_[static_cast<std::size_t>(i)].store(0, std::memory_order_relaxed);
+            t_ns_[static_cast<std::size_t>(i)] = 0;
+        }
+    }
+
+    void PcenRingBuffer::PushFrame(const float* frame, std::int64_t t_ns) {
+        if (!frame) return;
+        float* dst = AcquireFrame();
+        if (!dst) return;
+        std::memcpy(dst, frame, static_cast<std::size_t>(n_mels_) * sizeof(float));
+        CommitFrame(t_ns);
     }
 
-    void PcenRingBuffer::PushFrame(const float* frame) {
-        if (!frame || n_mels_ <= 0 || capacity_frames_ <= 0) return;
+    float* PcenRingBuffer::AcquireFrame() {
+        if (n_mels_ <= 0 || capacity_frames_ <= 0) return nullptr;
 
-        std::lock_guard<std::mutex> lk(mu_);
-        const std::size_t off = static_cast<std::size_t>(write_idx_) * static_cast<std::size_t>(n_mels_);
-        std::memcpy(data_.data() + off, frame, static_cast<std::size_t>(n_mels_) * sizeof(float));
+        const std::uint64_t f = head_.load(std::memory_order_relaxed);  // single writer
+        const std::size_t slot = static_cast<std::size_t>(f % static_cast<std::uint64_t>(slots_));
 
-        write_idx_ = (write_idx_ + 1) % capacity_frames_;
-        size_frames_ = std::min(size_frames_ + 1, capacity_frames_);
+        // Odd stamp first; the fence keeps the frame writes after it
+        seq_[slot].store(2 * f + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        return data_ + slot * static_cast<std::size_t>(n_mels_);
     }
 
-    std::vector<float> PcenRingBuffer::SnapshotLast(int last_frames, int* out_frames) const {
-        if (out_frames) *out_frames = 0;
-        if (n_mels_ <= 0 || capacity_frames_ <= 0) return {};
+    void PcenRingBuffer::CommitFrame(std::int64_t t_ns) {
+        if (n_mels_ <= 0 || capacity_frames_ <= 0) return;
 
-        std::lock_guard<std::mutex> lk(mu_);
-        const int avail = size_frames_;
-        const int want = std::max(0, std::min(last_frames, avail));
-        if (out_frames) *out_frames = want;
-        if (want == 0) return {};
+        const std::uint64_t f = head_.load(std::memory_order_relaxed);
+        const std::size_t slot = static_cast<std::size_t>(f % static_cast<std::uint64_t>(slots_));
+        t_ns_[slot] = t_ns;
+        seq_[slot].store(2 * f + 2, std::memory_order_release);
+        head_.store(f + 1, std::memory_order_release);
+    }
+
+    bool PcenRingBuffer::ViewRange(std::uint64_t first_seq, std::uint64_t end_seq, PcenRingView* out, int* lost) const {
+        *out = PcenRingView{};
+        if (lost) *lost = 0;
+        if (n_mels_ <= 0 || capacity_frames_ <= 0 || end_seq <= first_seq) return false;
+
+        const std::uint64_t slots = static_cast<std::uint64_t>(slots_);
+        const std::uint64_t head = head_.load(std::memory_order_acquire);
+        const std::uint64_t oldest = head - std::min<std::uint64_t>(head, static_cast<std::uint64_t>(capacity_frames_));
+        const std::uint64_t end = std::min(end_seq, head);
+        const std::uint64_t first = std::max(first_seq, oldest);
+        if (lost && first > first_seq) *lost = static_cast<int>(std::min(first, std::max(end, first_seq)) - first_seq);
+        if (first >= end) return false;
 
-        std::vector<float> out(static_cast<std::size_t>(want) * static_cast<std::size_t>(n_mels_), 0.0f);
+        const std::uint64_t count = end - first;
+        const std::size_t slot = static_cast<std::size_t>(first % slots);
+        // The mirror continues past the last slot, so the run never has to wrap
+        const int run1 = static_cast<int>(mirrored() ? count : std::min<std::uint64_t>(count, slots - slot));
+
+        out->first = data_ + slot * static_cast<std::size_t>(n_mels_);
+        out->first_frames = run1;
+        out->second = (run1 < static_cast<int>(count)) ? data_ : nullptr;
+        out->second_frames = static_cast<int>(count) - run1;
+        out->first_seq = first;
+        return true;
+    }
 
-        // Oldest among the last "want" frames:
-        // write_idx_ points to next write position => newest is write_idx_-1.
-        const int start = (write_idx_ - want + capacity_frames_) % capacity_frames_;
+    bool PcenRingBuffer::ViewLast(int last_frames, PcenRingView* out) const {
+        if (!out) return false;
+        *out = PcenRingView{};
+        if (last_frames <= 0) return false;
 
-        for (int i = 0; i < want; ++i) {
-            const int src_frame = (start + i) % capacity_frames_;
-            const std::size_t src_off = static_cast<std::size_t>(src_frame) * static_cast<std::size_t>(n_mels_);
-            const std::size_t dst_off = static_cast<std::size_t>(i) * static_cast<std::size_t>(n_mels_);
-            std::memcpy(out.data() + dst_off, data_.data() + src_off, static_cast<std::size_t>(n_mels_) * sizeof(float));
+        const std::uint64_t head = head_.load(std::memory_order_acquire);
+        const std::uint64_t want = std::min<std::uint64_t>(static_cast<std::uint64_t>(last_frames), head);
+        return ViewRange(head - want, head, out, nullptr);
+    }
+
+    bool PcenRingBuffer::Validate(const PcenRingView& view) const {
+        if (view.frames() <= 0 || slots_ <= 0) return false;
+
+        // The writer reuses slots in frame order, so any overwrite inside the view
+        // restamps the oldest frame's slot first: checking that one stamp is enough.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const std::size_t slot = static_cast<std::size_t>(view.first_seq % static_cast<std::uint64_t>(slots_));
+        return seq_[slot].load(std::memory_order_relaxed) == 2 * view.first_seq + 2;
+    }
+
+    int PcenRingBuffer::CopyLast(int last_frames, float* dst, int dst_frames) const {
+        if (!dst) return 0;
+        const int want = std::min(last_frames, dst_frames);
+        const std::size_t n = static_cast<std::size_t>(n_mels_);
+
+        for (int attempt = 0; attempt < kMaxReadAttempts; ++attempt) {
+            PcenRingView v;
+            if (!ViewLast(want, &v)) return 0;
+
+            // Plain copy validated by the stamp re-check (classic seqlock read)
+            std::memcpy(dst, v.first, static_cast<std::size_t>(v.first_frames) * n * sizeof(float));
+            if (v.second_frames > 0) {
+                std::memcpy(dst + static_cast<std::size_t>(v.first_frames) * n, v.second,
+                    static_cast<std::size_t>(v.second_frames) * n * sizeof(float));
+            }
+            if (Validate(v)) return v.frames();
+
+            read_retries_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return 0;
+    }
+
+    PcenRangeCopy PcenRingBuffer::CopyRange(std::uint64_t first_seq, std::uint64_t end_seq,
+        float* dst, int dst_frames, std::int64_t* t_ns_out) const {
+        PcenRangeCopy res;
+        if (!dst || dst_frames <= 0) return res;
+        end_seq = std::min(end_seq, first_seq + static_cast<std::uint64_t>(dst_frames));
+        const std::size_t n = static_cast<std::size_t>(n_mels_);
+
+        for (int attempt = 0; attempt < kMaxReadAttempts; ++attempt) {
+            PcenRingView v;
+            int lost = 0;
+            const bool any = ViewRange(first_seq, end_seq, &v, &lost);
+            res.lost_frames = lost;
+            if (!any) return res;
+
+            std::memcpy(dst, v.first, static_cast<std::size_t>(v.first_frames) * n * sizeof(float));
+            if (v.second_frames > 0) {
+                std::memcpy(dst + static_cast<std::size_t>(v.first_frames) * n, v.second,
+                    static_cast<std::size_t>(v.second_frames) * n * sizeof(float));
+            }
+            if (t_ns_out) {
+                for (int i = 0; i < v.frames(); ++i) {
+                    t_ns_out[i] = t_ns_[static_cast<std::size_t>((v.first_seq + static_cast<std::uint64_t>(i)) % static_cast<std::uint64_t>(slots_))];
+                }
+            }
+            if (Validate(v)) {
+                res.first_seq = v.first_seq;
+                res.frames = v.frames();
+                return res;
+            }
+
+            read_retries_.fetch_add(1, std::memory_order_relaxed);
         }
+        return res;
+    }
+
+    bool PcenRingBuffer::FrameTime(std::uint64_t seq, std::int64_t* t_ns) const {
+        if (!t_ns || slots_ <= 0) return false;
+
+        const std::size_t slot = static_cast<std::size_t>(seq % static_cast<std::uint64_t>(slots_));
+        const std::uint64_t stamp = 2 * seq + 2;
+        if (seq_[slot].load(std::memory_order_acquire) != stamp) return false;
+        const std::int64_t t = t_ns_[slot];
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq_[slot].load(std::memory_order_relaxed) != stamp) return false;
+        *t_ns = t;
+        return true;
+    }
+
+    std::vector<float> PcenRingBuffer::SnapshotLast(int last_frames, int* out_frames) const {
+        if (out_frames) *out_frames = 0;
+        if (n_mels_ <= 0 || capacity_frames_ <= 0 || last_frames <= 0) return {};
+
+        const int want = std::min(last_frames, capacity_frames_);
+        std::vector<float> out(static_cast<std::size_t>(want) * static_cast<std::size_t>(n_mels_));
+        const int got = CopyLast(want, out.data(), want);
+        out.resize(static_cast<std::size_t>(got) * static_cast<std::size_t>(n_mels_));
+        if (out_frames) *out_frames = got;
         return out;
     }
 
@@ -0,0 +1,161 @@
+#include "core/dsp/quantize_kernel.h"
+
+#include <cmath>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <emmintrin.h>
+#define UAV_QUANT_SSE2 1
+#else
+#define UAV_QUANT_SSE2 0
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define UAV_QUANT_NEON 1
+#else
+#define UAV_QUANT_NEON 0
+#endif
+
+namespace core::dsp {
+
+    namespace {
+
+        // Clamp bounds before rounding, relative to the zero point: the float -> int32
+        // conversion then never overflows and the narrowing packs are exact.
+        struct QuantRange {
+            float inv_scale;
+            float lo;  // qmin - zero_point
+            float hi;  // qmax - zero_point
+            int zero_point;
+        };
+
+        QuantRange MakeRange(const QuantParams& q, int qmin, int qmax) {
+            QuantRange r;
+            r.inv_scale = q.scale > 0.0f ? 1.0f / q.scale : 0.0f;
+            r.lo = static_cast<float>(qmin - q.zero_point);
+            r.hi = static_cast<float>(qmax - q.zero_point);
+            r.zero_point = q.zero_point;
+            return r;
+        }
+
+        template <typename T>
+        void QuantizeScalar(const float* src, std::size_t count, const QuantRange& r, T* dst) {
+            for (std::size_t i = 0; i < count; ++i) {
+                float v = src[i] * r.inv_scale;
+                if (!(v >= r.lo)) v = r.lo;  // also NaN
+                if (v > r.hi) v = r.hi;
+                // nearbyint: round half to even, as cvtps2dq / fcvtns
+                dst[i] = static_cast<T>(static_cast<int>(std::nearbyint(v)) + r.zero_point);
+            }
+        }
+
+#if UAV_QUANT_SSE2
+        inline __m128i Sse2Quant4(const float* src, __m128 inv, __m128 lo, __m128 hi, __m128i zp) {
+            __m128 v = _mm_mul_ps(_mm_loadu_ps(src), inv);
+            v = _mm_min_ps(_mm_max_ps(v, lo), hi);  // maxps returns lo for NaN
+            return _mm_add_epi32(_mm_cvtps_epi32(v), zp);
+        }
+
+        // 16 values per step; returns how many were done
+        template <bool kUnsigned>
+        std::size_t QuantizeSse2(const float* src, std::size_t count, const QuantRange& r, void* dst) {
+            const __m128 inv = _mm_set1_ps(r.inv_scale);
+            const __m128 lo = _mm_set1_ps(r.lo);
+            const __m128 hi = _mm_set1_ps(r.hi);
+            const __m128i zp = _mm_set1_epi32(r.zero_point);
+            auto* out = static_cast<std::uint8_t*>(dst);
+
+            std::size_t i = 0;
+            for (; i + 16 <= count; i += 16) {
+                const __m128i q0 = Sse2Quant4(src + i, inv, lo, hi, zp);
+                const __m128i q1 = Sse2Quant4(src + i + 4, inv, lo, hi, zp);
+                const __m128i q2 = Sse2Quant4(src + i + 8, inv, lo, hi, zp);
+                const __m128i q3 = Sse2Quant4(src + i + 12, inv, lo, hi, zp);
+                const __m128i a = _mm_packs_epi32(q0, q1);
+                const __m128i b = _mm_packs_epi32(q2, q3);
+                const __m128i q = kUnsigned ? _mm_packus_epi16(a, b) : _mm_packs_epi16(a, b);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), q);
+            }
+            return i;
+        }
+#endif
+
+#if UAV_QUANT_NEON
+        inline int16x8_t NeonQuant8(const float* src, float32x4_t inv, float32x4_t lo, float32x4_t hi, int32x4_t zp) {
+            float32x4_t v0 = vmulq_f32(vld1q_f32(src), inv);
+            float32x4_t v1 = vmulq_f32(vld1q_f32(src + 4), inv);
+            v0 = vminq_f32(vmaxnmq_f32(v0, lo), hi);  // maxnm returns lo for NaN
+            v1 = vminq_f32(vmaxnmq_f32(v1, lo), hi);
+            const int32x4_t q0 = vaddq_s32(vcvtnq_s32_f32(v0), zp);
+            const int32x4_t q1 = vaddq_s32(vcvtnq_s32_f32(v1), zp);
+            return vcombine_s16(vqmovn_s32(q0), vqmovn_s32(q1));
+        }
+
+        template <bool kUnsigned>
+        std::size_t QuantizeNeon(const float* src, std::size_t count, const QuantRange& r, void* dst) {
+            const float32x4_t inv = vdupq_n_f32(r.inv_scale);
+            const float32x4_t lo = vdupq_n_f32(r.lo);
+            const float32x4_t hi = vdupq_n_f32(r.hi);
+            const int32x4_t zp = vdupq_n_s32(r.zero_point);
+
+            std::size_t i = 0;
+            for (; i + 16 <= count; i += 16) {
+                const int16x8_t a = NeonQuant8(src + i, inv, lo, hi, zp);
+                const int16x8_t b = NeonQuant8(src + i + 8, inv, lo, hi, zp);
+                if constexpr (kUnsigned) {
+                    vst1q_u8(static_cast<std::uint8_t*>(dst) + i, vcombine_u8(vqmovun_s16(a), vqmovun_s16(b)));
+                }
+                else {
+                    vst1q_s8(static_cast<std::int8_t*>(dst) + i, vcombine_s8(vqmovn_s16(a), vqmovn_s16(b)));
+                }
+            }
+            return i;
+        }
+#endif
+
+        template <bool kUnsigned, typename T>
+        void Quantize(const float* src, std::size_t count, const QuantParams& q, T* dst) {
+            const QuantRange r = kUnsigned ? MakeRange(q, 0, 255) : MakeRange(q, -128, 127);
+            std::size_t done = 0;
+#if UAV_QUANT_SSE2
+            done = QuantizeSse2<kUnsigned>(src, count, r, dst);
+#elif UAV_QUANT_NEON
+            done = QuantizeNeon<kUnsigned>(src, count, r, dst);
+#endif
+            QuantizeScalar(src + done, count - done, r, dst + done);
+        }
+
+        template <typename T>
+        void Dequantize(const T* src, std::size_t count, const QuantParams& q, float* dst) {
+            for (std::size_t i = 0; i < count; ++i) {
+                dst[i] = static_cast<float>(static_cast<int>(src[i]) - q.zero_point) * q.scale;
+            }
+        }
+
+    }  // namespace
+
+    void QuantizeInt8(const float* src, std::size_t count, const QuantParams& q, std::int8_t* dst) {
+        Quantize<false>(src, count, q, dst);
+    }
+
+    void QuantizeUint8(const float* src, std::size_t count, const QuantParams& q, std::uint8_t* dst) {
+        Quantize<true>(src, count, q, dst);
+    }
+
+    void QuantizeInt8Reference(const float* src, std::size_t count, const QuantParams& q, std::int8_t* dst) {
+        QuantizeScalar(src, count, MakeRange(q, -128, 127), dst);
+    }
+
+    void QuantizeUint8Reference(const float* src, std::size_t count, const QuantParams& q, std::uint8_t* dst) {
+        QuantizeScalar(src, count, MakeRange(q, 0, 255), dst);
+    }
+
+    void DequantizeInt8(const std::int8_t* src, std::size_t count, const QuantParams& q, float* dst) {
+        Dequantize(src, count, q, dst);
+    }
+
+    void DequantizeUint8(const std::uint8_t* src, std::size_t count, const QuantParams& q, float* dst) {
+        Dequantize(src, count, q, dst);
+    }
+
+}  // namespace core::dsp
@@ -0,0 +1,69 @@
+#include "core/dsp/real_fft.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace core::dsp {
+
+    RealFft::RealFft(int n_fft)
+        : n_fft_(std::max(2, n_fft)),
+        plan_(n_fft_ / 2) {
+        const int half = n_fft_ / 2;
+        split_w_.resize(static_cast<std::size_t>(half));
+
+        // Twiddles in double precision: exact enough for any power-of-2 size we use.
+        const double step = -2.0 * std::numbers::pi / static_cast<double>(n_fft_);
+        for (int k = 0; k < half; ++k) {
+            const double ang = step * static_cast<double>(k);
+            split_w_[static_cast<std::size_t>(k)] = std::complex<float>(
+                static_cast<float>(std::cos(ang)), static_cast<float>(std::sin(ang)));
+        }
+    }
+
+    void RealFft::Forward(const float* in, std::complex<float>* out) {
+        const int half = n_fft_ / 2;
+
+        // Even/odd samples are already laid out as (re, im) pairs: read the input as
+        // N/2 complex values and let the plan gather them in bit-reversed order.
+        std::complex<float>* packed = plan_.scratch();
+        plan_.Forward(reinterpret_cast<const std::complex<float>*>(in), packed);
+
+        // Split: Z[k] = E[k] + i*O[k]  =>  X[k] = E[k] + W^k * O[k]
+        const std::complex<float> z0 = packed[0];
+        out[0] = std::complex<float>(z0.real() + z0.imag(), 0.0f);
+        out[half] = std::complex<float>(z0.real() - z0.imag(), 0.0f);
+
+        // Bins k and N/2-k share the same two packed values: with E = (Z[k] + conj(Z[N/2-k])) / 2,
+        // O = (Z[k] - conj(Z[N/2-k])) / 2i and W^(N/2-k) = -conj(W^k),
+        //   X[k] = E + W^k * O,  X[N/2-k] = conj(E - W^k * O)
+        // Plain float lanes: with std::complex temporaries GCC spills the twiddle to the stack
+        // as two floats and reloads it as one 8-byte value, a store-forwarding stall per bin.
+        const float* z = reinterpret_cast<const float*>(packed);
+        const float* w = reinterpret_cast<const float*>(split_w_.data());
+        float* o = reinterpret_cast<float*>(out);
+        for (int k = 1; k <= half / 2; ++k) {
+            const int kc = half - k;
+            const float ar = z[2 * k];
+            const float ai = z[2 * k + 1];
+            const float br = z[2 * kc];
+            const float bi = z[2 * kc + 1];
+
+            const float even_r = 0.5f * (ar + br);
+            const float even_i = 0.5f * (ai - bi);
+            const float odd_r = 0.5f * (ai + bi);
+            const float odd_i = -0.5f * (ar - br);
+
+            const float wr = w[2 * k];
+            const float wi = w[2 * k + 1];
+            const float t_r = wr * odd_r - wi * odd_i;
+            const float t_i = wr * odd_i + wi * odd_r;
+
+            o[2 * k] = even_r + t_r;
+            o[2 * k + 1] = even_i + t_i;
+            o[2 * kc] = even_r - t_r;
+            o[2 * kc + 1] = t_i - even_i;
+        }
+    }
+
+}  // namespace core::dsp
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace core::io {
+
+    // Memory-mapped file (POSIX mmap / Win32 file mapping).
+    // - Create(): new or truncated file of `size` bytes, mapped read-write
+    // - OpenRead(): existing file, mapped read-only
+    // Move-only; the mapping is flushed and released in Close() / destructor.
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        bool Create(const std::string& path, std::size_t size);
+        bool OpenRead(const std::string& path);
+
+        // Writes dirty pages back to the file (blocking).
+        bool Flush();
+        void Close();
+
+        bool is_open() const { return open_; }
+        bool writable() const { return writable_; }
+
+        // nullptr for an empty file
+        std::uint8_t* data() { return data_; }
+        const std::uint8_t* data() const { return data_; }
+        std::size_t size() const { return size_; }
+
+    private:
+        bool Map(const std::string& path, std::size_t size, bool create);
+        void Swap(MappedFile& other) noexcept;
+
+        std::uint8_t* data_ = nullptr;
+        std::size_t size_ = 0;
+        bool open_ = false;
+        bool writable_ = false;
+
+#if defined(_WIN32)
+        void* file_ = nullptr;     // HANDLE
+        void* mapping_ = nullptr;  // HANDLE
+#else
+        int fd_ = -1;
+#endif
+    };
+
+}  // namespace core::io
@@ -0,0 +1,190 @@
+#include "core/io/mapped_file.h"
+
+#include <iostream>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace core::io {
+
+    MappedFile::~MappedFile() { Close(); }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept { Swap(other); }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            Close();
+            Swap(other);
+        }
+        return *this;
+    }
+
+    void MappedFile::Swap(MappedFile& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(open_, other.open_);
+        std::swap(writable_, other.writable_);
+#if defined(_WIN32)
+        std::swap(file_, other.file_);
+        std::swap(mapping_, other.mapping_);
+#else
+        std::swap(fd_, other.fd_);
+#endif
+    }
+
+    bool MappedFile::Create(const std::string& path, std::size_t size) {
+        Close();
+        return Map(path, size, /*create=*/true);
+    }
+
+    bool MappedFile::OpenRead(const std::string& path) {
+        Close();
+        return Map(path, 0, /*create=*/false);
+    }
+
+#if defined(_WIN32)
+
+    bool MappedFile::Map(const std::string& path, std::size_t size, bool create) {
+        const DWORD access = create ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ;
+        const DWORD disposition = create ? CREATE_ALWAYS : OPEN_EXISTING;
+        HANDLE f = CreateFileA(path.c_str(), access, FILE_SHARE_READ, nullptr, disposition,
+            FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (f == INVALID_HANDLE_VALUE) {
+            std::cerr << "[MappedFile] cannot open " << path << " (error " << GetLastError() << ")\n";
+            return false;
+        }
+
+        if (!create) {
+            LARGE_INTEGER sz{};
+            if (!GetFileSizeEx(f, &sz)) {
+                std::cerr << "[MappedFile] cannot stat " << path << "\n";
+                CloseHandle(f);
+                return false;
+            }
+            size = static_cast<std::size_t>(sz.QuadPart);
+        }
+
+        file_ = f;
+        open_ = true;
+        writable_ = create;
+        size_ = size;
+        if (size == 0) return true;  // nothing to map
+
+        const DWORD protect = create ? PAGE_READWRITE : PAGE_READONLY;
+        const auto size64 = static_cast<unsigned long long>(size);
+        HANDLE m = CreateFileMappingA(f, nullptr, protect,
+            static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64 & 0xffffffffu), nullptr);
+        if (!m) {
+            std::cerr << "[MappedFile] CreateFileMapping failed for " << path << " (error " << GetLastError() << ")\n";
+            Close();
+            return false;
+        }
+        mapping_ = m;
+
+        void* p = MapViewOfFile(m, create ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size);
+        if (!p) {
+            std::cerr << "[MappedFile] MapViewOfFile failed for " << path << " (error " << GetLastError() << ")\n";
+            Close();
+            return false;
+        }
+        data_ = static_cast<std::uint8_t*>(p);
+        return true;
+    }
+
+    bool MappedFile::Flush() {
+        if (!data_ || !writable_) return open_;
+        if (!FlushViewOfFile(data_, 0)) return false;
+        return FlushFileBuffers(static_cast<HANDLE>(file_)) != 0;
+    }
+
+    void MappedFile::Close() {
+        if (data_) {
+            if (writable_) FlushViewOfFile(data_, 0);
+            UnmapViewOfFile(data_);
+        }
+        if (mapping_) CloseHandle(static_cast<HANDLE>(mapping_));
+        if (file_) CloseHandle(static_cast<HANDLE>(file_));
+        data_ = nullptr;
+        mapping_ = nullptr;
+        file_ = nullptr;
+        size_ = 0;
+        open_ = false;
+        writable_ = false;
+    }
+
+#else
+
+    bool MappedFile::Map(const std::string& path, std::size_t size, bool create) {
+        const int fd = create
+            ? ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)
+            : ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            std::cerr << "[MappedFile] cannot open " << path << "\n";
+            return false;
+        }
+
+        if (create) {
+            if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+                std::cerr << "[MappedFile] cannot resize " << path << " to " << size << " bytes\n";
+                ::close(fd);
+                return false;
+            }
+        }
+        else {
+            struct stat st {};
+            if (::fstat(fd, &st) != 0) {
+                std::cerr << "[MappedFile] cannot stat " << path << "\n";
+                ::close(fd);
+                return false;
+            }
+            size = static_cast<std::size_t>(st.st_size);
+        }
+
+        fd_ = fd;
+        open_ = true;
+        writable_ = create;
+        size_ = size;
+        if (size == 0) return true;  // nothing to map
+
+        const int prot = create ? (PROT_READ | PROT_WRITE) : PROT_READ;
+        void* p = ::mmap(nullptr, size, prot, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            std::cerr << "[MappedFile] mmap failed for " << path << "\n";
+            Close();
+            return false;
+        }
+        data_ = static_cast<std::uint8_t*>(p);
+        return true;
+    }
+
+    bool MappedFile::Flush() {
+        if (!data_ || !writable_) return open_;
+        return ::msync(data_, size_, MS_SYNC) == 0;
+    }
+
+    void MappedFile::Close() {
+        if (data_) ::munmap(data_, size_);
+        if (fd_ >= 0) ::close(fd_);
+        data_ = nullptr;
+        fd_ = -1;
+        size_ = 0;
+        open_ = false;
+        writable_ = false;
+    }
+
+#endif
+
+}  // namespace core::io
@@ -14,7 +14,7 @@ namespace core::segment {
     class SegmentBuilder {
     public:
         struct Config {
-            int n_mels = 64;
+            int n_mels = 64;  //  :  mel   ring buffer
 
             // hop_ms    PCEN hop ( 10ms  hop_length=160 @16kHz)
             int hop_ms = 10;
@@ -34,12 +34,16 @@ namespace core::segment {
             std::int64_t t_end_ns = 0;
             int frames = 0;
             int n_mels = 0;
+
+            std::uint64_t first_seq = 0;  //      ring buffer
+            int lost_frames = 0;          //  ,    ring buffer
         };
 
         SegmentBuilder(std::shared_ptr<const core::dsp::PcenRingBuffer> rb, Config cfg);
 
-        //    PushFrame (      ring buffer)
-        void OnFramePushed(std::int64_t t_ns);
+        //       ring buffer (   ).
+        //     ring buffer (frames_written),    .
+        void OnFramesPushed();
 
         // FSM 
         void OnEventStart(std::int64_t t_ns);
@@ -53,6 +57,7 @@ namespace core::segment {
         int pre_frames() const;
         int post_frames() const;
         int max_event_frames() const;
+        std::int64_t frame_index() const;  //    ring buffer
 
         void TryFinalizeIfReady();
 
@@ -64,14 +69,11 @@ namespace core::segment {
         std::shared_ptr<const core::dsp::PcenRingBuffer> rb_;
         Config cfg_;
 
-        //  PCEN  ()
-        std::int64_t frame_index_ = 0;
-        std::int64_t last_frame_t_ns_ = 0;
-
         //  
         bool in_event_ = false;
         bool pending_finalize_ = false;
 
+        //   ring buffer (PcenRingBuffer::frames_written)
         std::int64_t event_start_frame_ = -1;
         std::int64_t event_end_frame_ = -1;
         std::int64_t finalize_at_frame_ = -1;
@@ -82,6 +84,8 @@ namespace core::segment {
         //    ( 0/1)
         bool has_ready_ = false;
         SegmentInfo ready_;
+
+        std::vector<float> seg_buf_;  //   CopyRange ()
     };
 
 }  // namespace core::segment
@@ -4,6 +4,7 @@
 #include <cstdio>
 #include <filesystem>
 #include <fstream>
+#include <iostream>
 
 #include "core/dsp/pcen_ring_buffer.h"
 
@@ -25,14 +26,17 @@ namespace core::segment {
         return std::max(1, cfg_.max_event_ms / std::max(1, cfg_.hop_ms));
     }
 
-    void SegmentBuilder::OnFramePushed(std::int64_t t_ns) {
-        last_frame_t_ns_ = t_ns;
-        frame_index_++;
+    std::int64_t SegmentBuilder::frame_index() const {
+        return static_cast<std::int64_t>(rb_->frames_written());
+    }
 
+    void SegmentBuilder::OnFramesPushed() {
         //         END (  FSM)
         if (in_event_) {
-            const std::int64_t dur_frames = frame_index_ - event_start_frame_;
+            const std::int64_t dur_frames = frame_index() - event_start_frame_;
             if (dur_frames > max_event_frames()) {
+                std::int64_t t_ns = event_start_t_ns_;
+                (void)rb_->FrameTime(rb_->frames_written() - 1, &t_ns);
                 OnEventEnd(t_ns);
             }
         }
@@ -45,7 +49,7 @@ namespace core::segment {
 
         in_event_ = true;
         event_start_t_ns_ = t_ns;
-        event_start_frame_ = frame_index_;
+        event_start_frame_ = frame_index();
     }
 
     void SegmentBuilder::OnEventEnd(std::int64_t t_ns) {
@@ -53,7 +57,7 @@ namespace core::segment {
 
         in_event_ = false;
         event_end_t_ns_ = t_ns;
-        event_end_frame_ = frame_index_;
+        event_end_frame_ = frame_index();
 
         pending_finalize_ = true;
         finalize_at_frame_ = event_end_frame_ + post_frames();
@@ -70,25 +74,26 @@ namespace core::segment {
 
     void SegmentBuilder::TryFinalizeIfReady() {
         if (!pending_finalize_) return;
-        if (frame_index_ < finalize_at_frame_) return;
+        if (frame_index() < finalize_at_frame_) return;
 
-        const int n_mels = cfg_.n_mels;
+        const int n_mels = rb_->n_mels();
         const int pre = pre_frames();
-        const int post = post_frames();
 
-        //  : start_frame - pre
+        // : [start_frame - pre, end_frame + post)    ,   ring buffer
         const std::int64_t seg_begin_frame = std::max<std::int64_t>(0, event_start_frame_ - pre);
-        //  : end_frame + post  (finalize_at_frame_  )
-        const std::int64_t seg_end_frame = finalize_at_frame_;
-
-        const std::int64_t seg_frames_ll = std::max<std::int64_t>(1, seg_end_frame - seg_begin_frame);
-        const int seg_frames = static_cast<int>(std::min<std::int64_t>(seg_frames_ll, 5000)); // safety
-
-        //   seg_frames  ring buffer   finalize.
-        //  ring buffer   SnapshotLast  .
-        int available = 0;
-        std::vector<float> data = rb_->SnapshotLast(seg_frames, &available);
-        const int got_frames = std::max(0, available);
+        const std::int64_t seg_end_frame = std::min<std::int64_t>(finalize_at_frame_, seg_begin_frame + 5000); // safety
+        const int seg_frames = static_cast<int>(std::max<std::int64_t>(1, seg_end_frame - seg_begin_frame));
+
+        //    ; ,  ring buffer  ,   lost_frames.
+        seg_buf_.resize(static_cast<std::size_t>(seg_frames) * static_cast<std::size_t>(std::max(0, n_mels)));
+        const core::dsp::PcenRangeCopy copied = rb_->CopyRange(
+            static_cast<std::uint64_t>(seg_begin_frame), static_cast<std::uint64_t>(seg_end_frame),
+            seg_buf_.data(), seg_frames);
+        const int got_frames = copied.frames;
+        if (copied.lost_frames > 0) {
+            std::cerr << "[SegmentBuilder] " << copied.lost_frames << " of " << seg_frames
+                << " segment frames already overwritten in the ring buffer\n";
+        }
 
         // 
         EnsureOutDir();
@@ -100,9 +105,11 @@ namespace core::segment {
         info.t_end_ns = event_end_t_ns_;
         info.frames = got_frames;
         info.n_mels = n_mels;
+        info.first_seq = copied.first_seq;
+        info.lost_frames = copied.lost_frames;
 
-        if (got_frames > 0 && static_cast<int>(data.size()) >= got_frames * n_mels) {
-            (void)SaveCsv(path, data, got_frames, n_mels);
+        if (got_frames > 0) {
+            (void)SaveCsv(path, seg_buf_, got_frames, n_mels);
         }
 
         ready_ = info;
@@ -0,0 +1,56 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace core::telemetry {
+
+// Lock-free log-linear (HDR style) histogram of durations in nanoseconds.
+// Values below 16 ns get their own bucket; above that every power of two is split
+// into 16 linear sub-buckets, so any percentile is within 1/16 (6.25%) of the true
+// value. Covers the whole int64 range in 976 buckets (~8 KB).
+// Record() is a few relaxed atomic adds (any number of threads); readers see a
+// slightly stale but consistent-enough view without stopping writers.
+class LatencyHistogram {
+ public:
+  static constexpr int kSubBits = 4;
+  static constexpr int kSubBuckets = 1 << kSubBits;
+  static constexpr int kBuckets = (64 - kSubBits + 1) * kSubBuckets;
+
+  struct Summary {
+    std::uint64_t count = 0;
+    std::int64_t p50_ns = 0;
+    std::int64_t p99_ns = 0;
+    std::int64_t max_ns = 0;
+    double mean_ns = 0.0;
+  };
+
+  LatencyHistogram();
+
+  LatencyHistogram(const LatencyHistogram&) = delete;
+  LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+  void Record(std::int64_t ns);
+
+  // Upper edge of the bucket holding the q-quantile (q in [0, 1]), capped at max.
+  // 0 if nothing was recorded.
+  [[nodiscard]] std::int64_t Percentile(double q) const;
+  [[nodiscard]] Summary Summarize() const;
+
+  [[nodiscard]] std::uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+  [[nodiscard]] std::int64_t max() const { return max_.load(std::memory_order_relaxed); }
+
+  // Not atomic with respect to concurrent Record() calls
+  void Reset();
+
+  static int BucketOf(std::uint64_t v);
+  static std::uint64_t BucketUpper(int bucket);
+
+ private:
+  std::array<std::atomic<std::uint64_t>, kBuckets> buckets_;
+  std::atomic<std::uint64_t> count_{0};
+  std::atomic<std::uint64_t> sum_{0};
+  std::atomic<std::int64_t> max_{0};
+};
+
+}  // namespace core::telemetry
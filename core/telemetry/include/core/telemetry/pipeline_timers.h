@@ -0,0 +1,76 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+
+#include "core/telemetry/latency_histogram.h"
+#include "core/telemetry/telemetry_snapshot.h"
+
+namespace core::telemetry {
+
+// Stage timers of the audio loop: one LatencyHistogram per PipelineStage plus the
+// processing/audio time totals behind the realtime factor. Histograms are cumulative
+// since construction; Summarize() reports the realtime factor since its previous call.
+// Recording is lock-free; Summarize() is meant for a single caller (the audio thread),
+// Dump() may run on any thread.
+class PipelineTimers {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // Times one stage from construction to Stop() / destruction
+  class Scope {
+   public:
+    Scope(PipelineTimers* timers, PipelineStage stage) : timers_(timers), stage_(stage), t0_(Clock::now()) {}
+    ~Scope() { Stop(); }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    void Stop() {
+      if (!timers_) return;
+      timers_->Record(stage_, std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0_).count());
+      timers_ = nullptr;
+    }
+
+   private:
+    PipelineTimers* timers_;
+    PipelineStage stage_;
+    Clock::time_point t0_;
+  };
+
+  PipelineTimers() = default;
+
+  PipelineTimers(const PipelineTimers&) = delete;
+  PipelineTimers& operator=(const PipelineTimers&) = delete;
+
+  void Record(PipelineStage stage, std::int64_t ns) { hist_[Index(stage)].Record(ns); }
+
+  // One processed chunk: busy_ns of work for audio_ns of audio
+  void RecordChunk(std::int64_t busy_ns, std::int64_t audio_ns);
+
+  [[nodiscard]] const LatencyHistogram& histogram(PipelineStage stage) const { return hist_[Index(stage)]; }
+
+  // p50/p99/max per stage and the realtime factor since the previous call
+  [[nodiscard]] PipelineLatency Summarize();
+
+  // Human-readable table (all stages, cumulative realtime factor)
+  void Dump(std::ostream& os) const;
+
+  static const char* StageName(PipelineStage stage);
+
+ private:
+  static std::size_t Index(PipelineStage stage) { return static_cast<std::size_t>(stage); }
+
+  std::array<LatencyHistogram, kPipelineStageCount> hist_;
+  std::atomic<std::int64_t> busy_ns_{0};
+  std::atomic<std::int64_t> audio_ns_{0};
+
+  // Totals at the previous Summarize()
+  std::int64_t last_busy_ns_ = 0;
+  std::int64_t last_audio_ns_ = 0;
+  float last_rtf_ = 0.0f;
+};
+
+}  // namespace core::telemetry
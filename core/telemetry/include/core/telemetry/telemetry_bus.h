@@ -1,4 +1,5 @@
 #pragma once
+#include <array>
 #include <atomic>
 #include <cstdint>
 #include <functional>
@@ -10,12 +11,66 @@
 
 namespace core::telemetry {
 
+namespace detail {
+class AsyncDelivery;
+}  // namespace detail
+
+// Latest snapshot + subscriber callbacks, RCU style (readers never block the publisher):
+// - Latest(): versions live in kLatestSlots slots; a reader pins the current slot
+//   (reader count), checks it is still current and unchanged, copies the shared_ptr.
+//   It retries only if a publish landed in those few instructions.
+// - Publish(): writes the new version into a slot nobody has pinned and makes it
+//   current; it never waits for readers. Old versions are released on slot reuse.
+// - Subscribers: Subscribe/Unsubscribe build a new immutable list (serialized by
+//   subs_write_mu_) and hand it over through an atomic pointer; Publish() picks it up
+//   with one exchange and calls the callbacks in place. A publish already running keeps
+//   its list, so a callback may still be called once after Unsubscribe() returns.
+// - Timeline: the bus keeps its own ring of TimelinePoint history (timeline_capacity
+//   points, minutes of data). Publishers append in O(1); readers hold a cursor and
+//   fetch only newer points. Same per-slot seqlock scheme as PcenRingBuffer.
+// - Async subscribers (SubscribeOptions::async): Publish() only puts the snapshot into
+//   the subscriber's bounded queue; a delivery thread per subscriber runs the callback,
+//   so a slow subscriber never stalls the publisher. On overflow the queue drops its
+//   oldest entry or coalesces to the newest one (OverflowPolicy).
+// Publishers are serialized by publish_mu_ (readers and subscribers never take it).
+// Synchronous callbacks run on the publishing thread after publish_mu_ is released: a
+// callback may publish or append to the timeline, and concurrent publishers may call
+// callbacks out of publish order.
 class TelemetryBus {
  public:
   using SnapshotPtr = std::shared_ptr<const TelemetrySnapshot>;
   using Callback = std::function<void(SnapshotPtr)>;
 
-  TelemetryBus();
+  // ~5.5 min at one point per 20 ms chunk
+  static constexpr int kDefaultTimelineCapacity = 16384;
+
+  enum class OverflowPolicy : int {
+    kDropOldest = 0,  // queue full: discard the oldest queued snapshot
+    kCoalesce = 1,    // queue full: discard everything queued, keep only the newest
+  };
+
+  struct SubscribeOptions {
+    bool async = false;  // false: callback runs inside Publish()
+    int queue_capacity = 16;
+    OverflowPolicy overflow = OverflowPolicy::kDropOldest;
+  };
+
+  // Per-subscriber delivery counters (async subscribers; sync ones only count delivered)
+  struct SubscriberStats {
+    std::uint64_t delivered = 0;  // callbacks completed
+    std::uint64_t dropped = 0;    // snapshots discarded by the overflow policy
+    int queued = 0;               // current lag in snapshots
+    int max_queued = 0;           // worst lag seen
+  };
+
+  // Result of ReadTimelineSince
+  struct TimelineRead {
+    std::uint64_t next_cursor = 0;  // pass back on the next call
+    int points = 0;                 // points written to out
+    int lost = 0;                   // points after the cursor already overwritten
+  };
+
+  explicit TelemetryBus(int timeline_capacity = kDefaultTimelineCapacity);
   ~TelemetryBus();
 
   TelemetryBus(const TelemetryBus&) = delete;
@@ -27,22 +82,64 @@ class TelemetryBus {
   [[nodiscard]] std::uint64_t PublishCount() const noexcept;
 
   [[nodiscard]] std::uint64_t Subscribe(Callback cb);
+  [[nodiscard]] std::uint64_t Subscribe(Callback cb, const SubscribeOptions& opt);
+  // Async subscribers: stops and joins the delivery thread (queued snapshots are dropped).
+  // Do not call for an async subscriber from inside its own callback.
   void Unsubscribe(std::uint64_t id);
   void ClearSubscriptions();
 
+  // false if `id` is not subscribed
+  bool GetSubscriberStats(std::uint64_t id, SubscriberStats* out) const;
+
+  // Appends one history point (publisher side, O(1)).
+  void AppendTimeline(const TimelinePoint& point);
+
+  // Points with cursor >= `cursor`, oldest first, at most max_points. Start with cursor 0
+  // (or TimelineHead() to skip history). Wait-free for the publisher; a reader that
+  // races a wrap-around retries.
+  TimelineRead ReadTimelineSince(std::uint64_t cursor, TimelinePoint* out, int max_points) const;
+
+  // Cursor just past the newest point
+  [[nodiscard]] std::uint64_t TimelineHead() const noexcept;
+  [[nodiscard]] int timeline_capacity() const noexcept { return timeline_capacity_; }
+
  private:
   struct Sub {
     std::uint64_t id = 0;
     Callback cb;
+    std::shared_ptr<detail::AsyncDelivery> async;  // null: synchronous
+    std::shared_ptr<std::atomic<std::uint64_t>> sync_delivered;
+  };
+  using SubList = std::vector<Sub>;
+
+  // More slots than concurrently pinning readers, so a free one always exists
+  static constexpr int kLatestSlots = 8;
+
+  struct alignas(64) LatestSlot {
+    mutable std::atomic<std::uint32_t> readers{0};  // pins
+    std::atomic<std::uint64_t> version{0};          // odd while the publisher rewrites ptr
+    SnapshotPtr ptr;
   };
 
-  mutable std::mutex latest_mu_;
-  SnapshotPtr latest_{};
+  void HandOverSubs(std::unique_ptr<SubList> next);
+
+  std::array<LatestSlot, kLatestSlots> slots_{};
+  std::atomic<int> current_{0};
   std::atomic<std::uint64_t> publish_count_{0};
+  std::mutex publish_mu_;
 
-  mutable std::mutex subs_mu_;
-  std::vector<Sub> subs_;
+  std::shared_ptr<const SubList> active_subs_;  // publisher-owned (under publish_mu_)
+  std::atomic<SubList*> pending_subs_{nullptr}; // newest list not yet picked up
+
+  mutable std::mutex subs_write_mu_;  // Subscribe/Unsubscribe/Clear/stats only
+  SubList subs_master_;       // under subs_write_mu_
   std::atomic<std::uint64_t> next_sub_id_{1};
+
+  // Timeline ring: point n lives in slot n % capacity, stamp 2n+1 while written, 2n+2 after
+  int timeline_capacity_ = 0;
+  std::unique_ptr<TimelinePoint[]> timeline_;
+  std::unique_ptr<std::atomic<std::uint64_t>[]> timeline_seq_;
+  alignas(64) std::atomic<std::uint64_t> timeline_head_{0};
 };
 
 }  // namespace core::telemetry
@@ -0,0 +1,114 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+#include "core/io/mapped_file.h"
+#include "core/telemetry/telemetry_snapshot.h"
+
+namespace core::telemetry {
+
+// Binary flight-recorder format (host byte order, little endian on all our targets).
+// File = RecordFileHeader + capacity fixed-size TelemetryRecord slots; only the first
+// `count` slots are valid. The header count is updated after every record, so a file
+// left behind by a crash is readable up to the last complete record.
+struct TelemetryRecord {
+  std::int64_t t_ns = 0;
+  float p_detect = 0.0f;
+  std::uint8_t fsm_state = 0;  // FsmState
+  std::uint8_t flags = 0;      // kRecordEvent*
+  std::uint8_t backend = 0;    // kRecordTcn*
+  std::uint8_t reserved = 0;
+};
+static_assert(sizeof(TelemetryRecord) == 16, "TelemetryRecord is an on-disk format");
+
+inline constexpr std::uint8_t kRecordEventStarted = 1u << 0;
+inline constexpr std::uint8_t kRecordEventEnded = 1u << 1;
+inline constexpr std::uint8_t kRecordTcnAvailable = 1u << 0;
+inline constexpr std::uint8_t kRecordTcnUsed = 1u << 1;
+
+struct RecordFileHeader {
+  char magic[8];               // kRecordFileMagic
+  std::uint32_t version;       // kRecordFileVersion
+  std::uint32_t record_size;   // sizeof(TelemetryRecord)
+  std::uint64_t capacity;      // record slots in the file
+  std::uint64_t count;         // valid records
+  std::uint64_t file_index;    // rotation number (0, 1, 2, ...)
+  std::int64_t created_ns;     // wall clock, for humans
+  std::uint8_t reserved[16];
+};
+static_assert(sizeof(RecordFileHeader) == 64, "RecordFileHeader is an on-disk format");
+
+inline constexpr char kRecordFileMagic[8] = {'U', 'A', 'V', 'T', 'R', 'E', 'C', '\0'};
+inline constexpr std::uint32_t kRecordFileVersion = 1;
+
+TelemetryRecord EncodeRecord(const TelemetrySnapshot& s);
+void DecodeRecord(const TelemetryRecord& r, TelemetrySnapshot* out);
+
+// Appends snapshots to preallocated memory-mapped files <prefix>_NNNNNN.trec.
+// Record() is a 16-byte store into the mapping plus a header update: no syscalls,
+// no allocation. When a file is full the next one is created (one mmap, every
+// records_per_file snapshots) and files older than the newest max_files are deleted.
+// Single writer: call Record() from one thread (e.g. a TelemetryBus subscriber).
+class TelemetryRecorder {
+ public:
+  struct Config {
+    std::string path_prefix;                    // e.g. "telemetry/rec"
+    std::uint64_t records_per_file = 1u << 16;  // ~22 min at one snapshot per 20 ms (1 MB)
+    int max_files = 8;                          // 0: keep every file
+  };
+
+  struct Stats {
+    std::uint64_t records = 0;         // records written since Open()
+    std::uint64_t files = 0;           // files created since Open()
+    std::uint64_t write_failures = 0;  // records lost because a file could not be created
+  };
+
+  TelemetryRecorder() = default;
+  ~TelemetryRecorder();
+
+  TelemetryRecorder(const TelemetryRecorder&) = delete;
+  TelemetryRecorder& operator=(const TelemetryRecorder&) = delete;
+
+  // Creates the first file. Existing files with the same prefix are overwritten.
+  bool Open(const Config& cfg);
+  void Close();
+
+  void Record(const TelemetrySnapshot& s);
+
+  bool is_open() const { return file_.is_open(); }
+  const Stats& stats() const { return stats_; }
+  // Path of the file currently written (empty if closed)
+  std::string current_path() const;
+
+  static std::string FileName(const std::string& prefix, std::uint64_t file_index);
+
+ private:
+  bool OpenFile(std::uint64_t file_index);
+
+  Config cfg_;
+  Stats stats_;
+  core::io::MappedFile file_;
+  RecordFileHeader* header_ = nullptr;
+  TelemetryRecord* records_ = nullptr;
+  std::uint64_t file_index_ = 0;
+};
+
+// Read-only view of one recorder file.
+class TelemetryRecordReader {
+ public:
+  // false (with a message) if the file is missing or not a recorder file
+  bool Open(const std::string& path);
+  void Close() { file_.Close(); header_ = nullptr; records_ = nullptr; count_ = 0; }
+
+  std::uint64_t count() const { return count_; }
+  std::uint64_t file_index() const { return header_ ? header_->file_index : 0; }
+  const TelemetryRecord* records() const { return records_; }
+
+ private:
+  core::io::MappedFile file_;
+  const RecordFileHeader* header_ = nullptr;
+  const TelemetryRecord* records_ = nullptr;
+  std::uint64_t count_ = 0;
+};
+
+}  // namespace core::telemetry
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <cstddef>
 
@@ -12,6 +13,32 @@ namespace core::telemetry {
 		COOLDOWN = 3,
 	};
 
+	// Audio loop stages timed by PipelineTimers (core/telemetry/pipeline_timers.h)
+	enum class PipelineStage : int {
+		SOURCE_READ = 0, // includes the realtime pacing wait of the replay source
+		DOWNMIX = 1,
+		PCEN = 2,
+		INFERENCE = 3,   // mock detector + handing windows to / results from the TCN worker
+		FSM = 4,
+		SEGMENT = 5,
+		PUBLISH = 6,     // timeline append + snapshot publish
+		CHUNK_TOTAL = 7, // whole chunk except SOURCE_READ
+		MODEL = 8,       // TCN Invoke on the inference worker (per window, off the audio thread)
+	};
+	inline constexpr int kPipelineStageCount = 9;
+
+	struct StageLatency {
+		float p50_us = 0.0f;
+		float p99_us = 0.0f;
+		float max_us = 0.0f;
+	};
+
+	struct PipelineLatency {
+		std::array<StageLatency, kPipelineStageCount> stages{}; // indexed by PipelineStage
+		// Processing time / audio time over the last summary window (< 1: keeps up)
+		float realtime_factor = 0.0f;
+	};
+
 	struct TimelinePoint {
 		std::int64_t t_ns = 0;
 		float p_detect = 0.0f;
@@ -21,6 +48,9 @@ namespace core::telemetry {
 		std::int64_t t_ns = 0;
 
 		float p_detect_latest = 0.0f;
+		// Time of the audio p_detect_latest was computed from (newest frame of the TCN
+		// window, or the chunk start for the mock detector)
+		std::int64_t p_detect_t_ns = 0;
 		FsmState fsm_state = FsmState::IDLE;
 
 		// New: event flags (edge events)
@@ -33,10 +63,11 @@ namespace core::telemetry {
 		bool tcn_available = false;
 		bool tcn_used_for_latest = false;
 
-		// Timeline (fixed-size buffer like before)
-		static constexpr std::size_t kMaxTimeline = 128;
-		TimelinePoint timeline[kMaxTimeline]{};
-		int timeline_n = 0;
+		// Per-stage latency of the audio loop (refreshed a few times per second)
+		PipelineLatency latency;
+
+		// p_detect history is not part of the snapshot: see TelemetryBus::AppendTimeline /
+		// ReadTimelineSince.
 	};
 
 }  // namespace core::telemetry
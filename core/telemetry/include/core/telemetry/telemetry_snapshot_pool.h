@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+
+#include "core/telemetry/telemetry_snapshot.h"
+
+namespace core::telemetry {
+
+namespace detail {
+class SnapshotSlab;
+}  // namespace detail
+
+// Fixed-capacity pool of TelemetrySnapshot objects.
+// Acquire() returns a fresh (value-initialized) snapshot whose object and shared_ptr
+// control block live in one pool slot (allocate_shared with a slot allocator).
+// When the last holder releases it, the slot goes back to the pool (an atomic flag)
+// without touching the global allocator. Acquire/release are lock-free.
+// If every slot is in use, Acquire() falls back to the heap and counts it.
+// Slots stay valid while any snapshot is alive, even after the pool is destroyed.
+//
+// Size the pool above the number of snapshots alive at once: TelemetryBus keeps up to
+// 8 recent versions, plus whatever subscribers and the UI hold.
+class TelemetrySnapshotPool {
+ public:
+  struct Stats {
+    std::uint64_t acquired = 0;        // Acquire() calls
+    std::uint64_t heap_fallbacks = 0;  // of those, served by the global allocator (pool full)
+    int in_use = 0;                    // pool slots currently held
+    int capacity = 0;
+  };
+
+  explicit TelemetrySnapshotPool(int capacity = 32);
+  ~TelemetrySnapshotPool();
+
+  TelemetrySnapshotPool(const TelemetrySnapshotPool&) = delete;
+  TelemetrySnapshotPool& operator=(const TelemetrySnapshotPool&) = delete;
+
+  [[nodiscard]] std::shared_ptr<TelemetrySnapshot> Acquire();
+
+  [[nodiscard]] Stats stats() const;
+
+ private:
+  detail::SnapshotSlab* slab_;  // reference counted, see SnapshotSlab
+};
+
+}  // namespace core::telemetry
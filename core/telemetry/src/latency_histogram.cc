@@ -0,0 +1,71 @@
+#include "core/telemetry/latency_histogram.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace core::telemetry {
+
+LatencyHistogram::LatencyHistogram() { Reset(); }
+
+int LatencyHistogram::BucketOf(std::uint64_t v) {
+  if (v < static_cast<std::uint64_t>(kSubBuckets)) return static_cast<int>(v);
+  // Exponent e >= kSubBits, then the kSubBits bits below the leading one
+  const int e = 63 - std::countl_zero(v);
+  const int sub = static_cast<int>((v >> (e - kSubBits)) & static_cast<std::uint64_t>(kSubBuckets - 1));
+  return (e - kSubBits + 1) * kSubBuckets + sub;
+}
+
+std::uint64_t LatencyHistogram::BucketUpper(int bucket) {
+  if (bucket < kSubBuckets) return static_cast<std::uint64_t>(bucket);
+  const int e = bucket / kSubBuckets + kSubBits - 1;
+  const std::uint64_t sub = static_cast<std::uint64_t>(bucket % kSubBuckets);
+  const std::uint64_t width = std::uint64_t{1} << (e - kSubBits);
+  return ((static_cast<std::uint64_t>(kSubBuckets) + sub) << (e - kSubBits)) + (width - 1);
+}
+
+void LatencyHistogram::Record(std::int64_t ns) {
+  const std::uint64_t v = static_cast<std::uint64_t>(std::max<std::int64_t>(0, ns));
+  buckets_[static_cast<std::size_t>(BucketOf(v))].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(v, std::memory_order_relaxed);
+
+  std::int64_t cur = max_.load(std::memory_order_relaxed);
+  while (static_cast<std::int64_t>(v) > cur &&
+         !max_.compare_exchange_weak(cur, static_cast<std::int64_t>(v), std::memory_order_relaxed)) {
+  }
+}
+
+std::int64_t LatencyHistogram::Percentile(double q) const {
+  const std::uint64_t n = count();
+  if (n == 0) return 0;
+  const double qc = std::clamp(q, 0.0, 1.0);
+  const std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(qc * static_cast<double>(n))));
+
+  std::uint64_t seen = 0;
+  for (int b = 0; b < kBuckets; ++b) {
+    seen += buckets_[static_cast<std::size_t>(b)].load(std::memory_order_relaxed);
+    if (seen >= rank) return std::min(static_cast<std::int64_t>(BucketUpper(b)), max());
+  }
+  return max();  // buckets lag count_ under concurrent Record()
+}
+
+LatencyHistogram::Summary LatencyHistogram::Summarize() const {
+  Summary s;
+  s.count = count();
+  if (s.count == 0) return s;
+  s.p50_ns = Percentile(0.50);
+  s.p99_ns = Percentile(0.99);
+  s.max_ns = max();
+  s.mean_ns = static_cast<double>(sum_.load(std::memory_order_relaxed)) / static_cast<double>(s.count);
+  return s;
+}
+
+void LatencyHistogram::Reset() {
+  for (auto& b : buckets_) b.store(0, std::memory_order_relaxed);
+  count_.store(0, std::memory_order_relaxed);
+  sum_.store(0, std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace core::telemetry
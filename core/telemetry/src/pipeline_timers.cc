@@ -0,0 +1,72 @@
+#include "core/telemetry/pipeline_timers.h"
+
+#include <cstdio>
+#include <ostream>
+
+namespace core::telemetry {
+
+const char* PipelineTimers::StageName(PipelineStage stage) {
+  switch (stage) {
+    case PipelineStage::SOURCE_READ: return "source_read";
+    case PipelineStage::DOWNMIX: return "downmix";
+    case PipelineStage::PCEN: return "pcen";
+    case PipelineStage::INFERENCE: return "inference";
+    case PipelineStage::FSM: return "fsm";
+    case PipelineStage::SEGMENT: return "segment";
+    case PipelineStage::PUBLISH: return "publish";
+    case PipelineStage::CHUNK_TOTAL: return "chunk_total";
+    case PipelineStage::MODEL: return "model";
+  }
+  return "?";
+}
+
+void PipelineTimers::RecordChunk(std::int64_t busy_ns, std::int64_t audio_ns) {
+  busy_ns_.fetch_add(busy_ns, std::memory_order_relaxed);
+  audio_ns_.fetch_add(audio_ns, std::memory_order_relaxed);
+}
+
+PipelineLatency PipelineTimers::Summarize() {
+  PipelineLatency out;
+  for (int i = 0; i < kPipelineStageCount; ++i) {
+    const LatencyHistogram::Summary s = hist_[static_cast<std::size_t>(i)].Summarize();
+    StageLatency& st = out.stages[static_cast<std::size_t>(i)];
+    st.p50_us = static_cast<float>(s.p50_ns) * 1e-3f;
+    st.p99_us = static_cast<float>(s.p99_ns) * 1e-3f;
+    st.max_us = static_cast<float>(s.max_ns) * 1e-3f;
+  }
+
+  const std::int64_t busy = busy_ns_.load(std::memory_order_relaxed);
+  const std::int64_t audio = audio_ns_.load(std::memory_order_relaxed);
+  if (audio > last_audio_ns_) {
+    last_rtf_ = static_cast<float>(static_cast<double>(busy - last_busy_ns_) /
+                                   static_cast<double>(audio - last_audio_ns_));
+    last_busy_ns_ = busy;
+    last_audio_ns_ = audio;
+  }
+  out.realtime_factor = last_rtf_;
+  return out;
+}
+
+void PipelineTimers::Dump(std::ostream& os) const {
+  const std::int64_t busy = busy_ns_.load(std::memory_order_relaxed);
+  const std::int64_t audio = audio_ns_.load(std::memory_order_relaxed);
+
+  char line[160];
+  std::snprintf(line, sizeof(line), "%-12s %10s %10s %10s %10s %10s\n", "stage", "count", "p50_us", "p99_us",
+                "max_us", "mean_us");
+  os << line;
+  for (int i = 0; i < kPipelineStageCount; ++i) {
+    const auto stage = static_cast<PipelineStage>(i);
+    const LatencyHistogram::Summary s = hist_[static_cast<std::size_t>(i)].Summarize();
+    std::snprintf(line, sizeof(line), "%-12s %10llu %10.1f %10.1f %10.1f %10.1f\n", StageName(stage),
+                  static_cast<unsigned long long>(s.count), static_cast<double>(s.p50_ns) * 1e-3,
+                  static_cast<double>(s.p99_ns) * 1e-3, static_cast<double>(s.max_ns) * 1e-3, s.mean_ns * 1e-3);
+    os << line;
+  }
+  std::snprintf(line, sizeof(line), "realtime factor %.4f (%.1f s processing for %.1f s audio)\n",
+                audio > 0 ? static_cast<double>(busy) / static_cast<double>(audio) : 0.0,
+                static_cast<double>(busy) * 1e-9, static_cast<double>(audio) * 1e-9);
+  os << line;
+}
+
+}  // namespace core::telemetry
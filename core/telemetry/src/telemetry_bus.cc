@@ -1,76 +1,316 @@
 #include "core/telemetry/telemetry_bus.h"
 
 #include <algorithm>
+#include <condition_variable>
+#include <thread>
 #include <utility>
 
 namespace core::telemetry {
 
-TelemetryBus::TelemetryBus() {
-    std::lock_guard<std::mutex> lk(latest_mu_);
-    latest_.reset();
+namespace detail {
+
+// Bounded snapshot queue + delivery thread for one async subscriber.
+// Push() never blocks on the callback: it takes mu_ only to store the pointer.
+class AsyncDelivery : public std::enable_shared_from_this<AsyncDelivery> {
+ public:
+  using SnapshotPtr = TelemetryBus::SnapshotPtr;
+
+  AsyncDelivery(TelemetryBus::Callback cb, const TelemetryBus::SubscribeOptions& opt)
+      : cb_(std::move(cb)),
+        policy_(opt.overflow),
+        queue_(static_cast<std::size_t>(std::max(1, opt.queue_capacity))) {}
+
+  void Start() {
+    // The thread holds a reference, so a detached thread never outlives its state
+    thread_ = std::thread([self = shared_from_this()] { self->Run(); });
+  }
+
+  void Push(const SnapshotPtr& snap) {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      if (stop_) return;
+      const std::size_t cap = queue_.size();
+      if (size_ == cap) {
+        if (policy_ == TelemetryBus::OverflowPolicy::kCoalesce) {
+          dropped_ += size_;
+          for (std::size_t i = 0; i < size_; ++i) queue_[(head_ + i) % cap].reset();
+          size_ = 0;
+        } else {
+          queue_[head_].reset();
+          head_ = (head_ + 1) % cap;
+          --size_;
+          ++dropped_;
+        }
+      }
+      queue_[(head_ + size_) % cap] = snap;
+      ++size_;
+      max_queued_ = std::max(max_queued_, static_cast<int>(size_));
+    }
+    cv_.notify_one();
+  }
+
+  void Stop() {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      stop_ = true;
+    }
+    cv_.notify_one();
+    if (!thread_.joinable()) return;
+    if (thread_.get_id() == std::this_thread::get_id()) {
+      thread_.detach();  // called from the callback itself
+    } else {
+      thread_.join();
+    }
+  }
+
+  TelemetryBus::SubscriberStats Stats() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    TelemetryBus::SubscriberStats st;
+    st.delivered = delivered_;
+    st.dropped = dropped_;
+    st.queued = static_cast<int>(size_) + (in_callback_ ? 1 : 0);
+    st.max_queued = max_queued_;
+    return st;
+  }
+
+ private:
+  void Run() {
+    for (;;) {
+      SnapshotPtr snap;
+      {
+        std::unique_lock<std::mutex> lk(mu_);
+        cv_.wait(lk, [this] { return stop_ || size_ > 0; });
+        if (stop_) break;
+        snap = std::move(queue_[head_]);
+        head_ = (head_ + 1) % queue_.size();
+        --size_;
+        in_callback_ = true;
+      }
+      try { cb_(snap); } catch (...) {}
+      std::lock_guard<std::mutex> lk(mu_);
+      in_callback_ = false;
+      ++delivered_;
+    }
+    // Release queued snapshots (they may belong to a pool)
+    std::lock_guard<std::mutex> lk(mu_);
+    for (auto& q : queue_) q.reset();
+    size_ = 0;
+  }
+
+  TelemetryBus::Callback cb_;
+  TelemetryBus::OverflowPolicy policy_;
+
+  mutable std::mutex mu_;
+  std::condition_variable cv_;
+  std::vector<SnapshotPtr> queue_;  // ring, fixed capacity
+  std::size_t head_ = 0;
+  std::size_t size_ = 0;
+  bool stop_ = false;
+  bool in_callback_ = false;  // a popped snapshot still counts as queued until delivered
+
+  std::uint64_t delivered_ = 0;
+  std::uint64_t dropped_ = 0;
+  int max_queued_ = 0;
+
+  std::thread thread_;
+};
+
+}  // namespace detail
+
+TelemetryBus::TelemetryBus(int timeline_capacity)
+    : active_subs_(std::make_shared<const SubList>()),
+      timeline_capacity_(std::max(1, timeline_capacity)),
+      timeline_(std::make_unique<TimelinePoint[]>(static_cast<std::size_t>(timeline_capacity_))),
+      timeline_seq_(std::make_unique<std::atomic<std::uint64_t>[]>(static_cast<std::size_t>(timeline_capacity_))) {
+  for (int i = 0; i < timeline_capacity_; ++i) timeline_seq_[static_cast<std::size_t>(i)].store(0, std::memory_order_relaxed);
 }
 
-TelemetryBus::~TelemetryBus() = default;
+TelemetryBus::~TelemetryBus() {
+  ClearSubscriptions();  // stops async delivery threads
+  delete pending_subs_.exchange(nullptr);
+}
 
 void TelemetryBus::Publish(std::shared_ptr<TelemetrySnapshot> snapshot) {
   if (!snapshot) return;
 
   SnapshotPtr frozen = std::const_pointer_cast<const TelemetrySnapshot>(std::move(snapshot));
-  {
-      std::lock_guard<std::mutex> lk(latest_mu_);
-      latest_ = std::move(frozen);
-  }
-  publish_count_.fetch_add(1, std::memory_order_relaxed);
+  std::unique_lock<std::mutex> lk(publish_mu_);
 
-  std::vector<Callback> callbacks;
-  {
-    std::lock_guard<std::mutex> lk(subs_mu_);
-    callbacks.reserve(subs_.size());
-    for (const auto& s : subs_) {
-      if (s.cb) callbacks.push_back(s.cb);
+  // Next slot that no reader has pinned. Marking it odd before re-checking the pins
+  // (both seq_cst) means a reader either sees the odd version or is seen here.
+  const int cur = current_.load(std::memory_order_relaxed);
+  for (int k = 1;; ++k) {
+    if (k % kLatestSlots == 0) {
+      std::this_thread::yield();  // every other slot pinned right now (more readers than slots)
+      continue;
     }
+    LatestSlot& slot = slots_[static_cast<std::size_t>((cur + k) % kLatestSlots)];
+    if (slot.readers.load() != 0) continue;
+
+    const std::uint64_t v = slot.version.load(std::memory_order_relaxed);
+    slot.version.store(v + 1);
+    if (slot.readers.load() != 0) {
+      slot.version.store(v + 2, std::memory_order_release);  // a reader slipped in: leave it
+      continue;
+    }
+    slot.ptr = frozen;  // drops the version this slot held before
+    slot.version.store(v + 2, std::memory_order_release);
+    current_.store((cur + k) % kLatestSlots, std::memory_order_release);
+    break;
   }
+  publish_count_.fetch_add(1, std::memory_order_relaxed);
 
-  SnapshotPtr cur;
-  {
-      std::lock_guard<std::mutex> lk(latest_mu_);
-      cur = latest_;
+  // Pick up a new subscriber list if one was handed over. Callbacks run on a copy of the
+  // list with the lock released, so they may Publish() / AppendTimeline() themselves.
+  if (SubList* next = pending_subs_.exchange(nullptr, std::memory_order_acquire)) {
+    active_subs_.reset(next);
   }
-  if (!cur) return;
+  const std::shared_ptr<const SubList> subs = active_subs_;
+  lk.unlock();
 
-  for (auto& cb : callbacks) {
-    try { cb(cur); } catch (...) {}
+  for (const auto& s : *subs) {
+    if (s.async) {
+      s.async->Push(frozen);
+      continue;
+    }
+    try { s.cb(frozen); } catch (...) {}
+    s.sync_delivered->fetch_add(1, std::memory_order_relaxed);
   }
 }
 
 TelemetryBus::SnapshotPtr TelemetryBus::Latest() const noexcept {
-    std::lock_guard<std::mutex> lk(latest_mu_);
-    return latest_;
+  for (;;) {
+    const int i = current_.load(std::memory_order_acquire);
+    const LatestSlot& slot = slots_[static_cast<std::size_t>(i)];
+    slot.readers.fetch_add(1);
+    const std::uint64_t v = slot.version.load();
+    if ((v & 1) == 0 && current_.load() == i) {
+      SnapshotPtr out = slot.ptr;
+      slot.readers.fetch_sub(1, std::memory_order_release);
+      return out;
+    }
+    slot.readers.fetch_sub(1, std::memory_order_release);  // publish in progress: retry
+  }
 }
 
 std::uint64_t TelemetryBus::PublishCount() const noexcept {
   return publish_count_.load(std::memory_order_relaxed);
 }
 
+void TelemetryBus::AppendTimeline(const TimelinePoint& point) {
+  std::lock_guard<std::mutex> lk(publish_mu_);
+  const std::uint64_t n = timeline_head_.load(std::memory_order_relaxed);
+  const std::size_t slot = static_cast<std::size_t>(n % static_cast<std::uint64_t>(timeline_capacity_));
+
+  timeline_seq_[slot].store(2 * n + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  timeline_[slot] = point;
+  timeline_seq_[slot].store(2 * n + 2, std::memory_order_release);
+  timeline_head_.store(n + 1, std::memory_order_release);
+}
+
+TelemetryBus::TimelineRead TelemetryBus::ReadTimelineSince(std::uint64_t cursor, TimelinePoint* out,
+                                                           int max_points) const {
+  TimelineRead res;
+  res.next_cursor = cursor;
+  if (!out || max_points <= 0) return res;
+
+  const std::uint64_t cap = static_cast<std::uint64_t>(timeline_capacity_);
+  for (;;) {
+    const std::uint64_t head = timeline_head_.load(std::memory_order_acquire);
+    const std::uint64_t oldest = head - std::min(head, cap);
+    const std::uint64_t first = std::max(std::min(cursor, head), oldest);
+    const std::uint64_t end = std::min(head, first + static_cast<std::uint64_t>(max_points));
+    res.lost = static_cast<int>(first > cursor ? first - cursor : 0);
+    res.points = static_cast<int>(end - first);
+    res.next_cursor = end;
+    if (res.points == 0) return res;
+
+    // Oldest to newest in at most two runs, then one stamp check: slots are reused in
+    // order, so an overwrite anywhere in the range restamps the first slot first.
+    const std::size_t slot = static_cast<std::size_t>(first % cap);
+    const std::size_t run1 = std::min<std::size_t>(static_cast<std::size_t>(res.points), static_cast<std::size_t>(cap) - slot);
+    std::copy_n(timeline_.get() + slot, run1, out);
+    std::copy_n(timeline_.get(), static_cast<std::size_t>(res.points) - run1, out + run1);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (timeline_seq_[slot].load(std::memory_order_relaxed) == 2 * first + 2) return res;
+  }
+}
+
+std::uint64_t TelemetryBus::TimelineHead() const noexcept {
+  return timeline_head_.load(std::memory_order_acquire);
+}
+
+void TelemetryBus::HandOverSubs(std::unique_ptr<SubList> next) {
+  // Replaces a list the publisher has not picked up yet (it was never seen by anyone)
+  delete pending_subs_.exchange(next.release(), std::memory_order_release);
+}
+
 std::uint64_t TelemetryBus::Subscribe(Callback cb) {
+  return Subscribe(std::move(cb), SubscribeOptions{});
+}
+
+std::uint64_t TelemetryBus::Subscribe(Callback cb, const SubscribeOptions& opt) {
   if (!cb) return 0;
   const std::uint64_t id = next_sub_id_.fetch_add(1, std::memory_order_relaxed);
-  std::lock_guard<std::mutex> lk(subs_mu_);
-  subs_.push_back(Sub{.id = id, .cb = std::move(cb)});
+
+  Sub sub;
+  sub.id = id;
+  if (opt.async) {
+    sub.async = std::make_shared<detail::AsyncDelivery>(std::move(cb), opt);
+    sub.async->Start();
+  } else {
+    sub.cb = std::move(cb);
+    sub.sync_delivered = std::make_shared<std::atomic<std::uint64_t>>(0);
+  }
+
+  std::lock_guard<std::mutex> lk(subs_write_mu_);
+  subs_master_.push_back(std::move(sub));
+  HandOverSubs(std::make_unique<SubList>(subs_master_));
   return id;
 }
 
 void TelemetryBus::Unsubscribe(std::uint64_t id) {
   if (id == 0) return;
-  std::lock_guard<std::mutex> lk(subs_mu_);
-  subs_.erase(std::remove_if(subs_.begin(), subs_.end(),
-                             [id](const Sub& s) { return s.id == id; }),
-              subs_.end());
+  std::shared_ptr<detail::AsyncDelivery> stopped;
+  {
+    std::lock_guard<std::mutex> lk(subs_write_mu_);
+    auto it = std::find_if(subs_master_.begin(), subs_master_.end(),
+                           [id](const Sub& s) { return s.id == id; });
+    if (it == subs_master_.end()) return;
+    stopped = std::move(it->async);
+    subs_master_.erase(it);
+    HandOverSubs(std::make_unique<SubList>(subs_master_));
+  }
+  if (stopped) stopped->Stop();  // outside the lock: joins the delivery thread
 }
 
 void TelemetryBus::ClearSubscriptions() {
-  std::lock_guard<std::mutex> lk(subs_mu_);
-  subs_.clear();
+  SubList removed;
+  {
+    std::lock_guard<std::mutex> lk(subs_write_mu_);
+    removed.swap(subs_master_);
+    HandOverSubs(std::make_unique<SubList>());
+  }
+  for (auto& s : removed) {
+    if (s.async) s.async->Stop();
+  }
+}
+
+bool TelemetryBus::GetSubscriberStats(std::uint64_t id, SubscriberStats* out) const {
+  if (!out) return false;
+  std::lock_guard<std::mutex> lk(subs_write_mu_);
+  for (const auto& s : subs_master_) {
+    if (s.id != id) continue;
+    if (s.async) {
+      *out = s.async->Stats();
+    } else {
+      *out = SubscriberStats{};
+      out->delivered = s.sync_delivered->load(std::memory_order_relaxed);
+    }
+    return true;
+  }
+  return false;
 }
 
 }  // namespace core::telemetry
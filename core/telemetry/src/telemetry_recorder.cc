@@ -0,0 +1,150 @@
+#include "core/telemetry/telemetry_recorder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+namespace core::telemetry {
+
+TelemetryRecord EncodeRecord(const TelemetrySnapshot& s) {
+  TelemetryRecord r;
+  r.t_ns = s.t_ns;
+  r.p_detect = s.p_detect_latest;
+  r.fsm_state = static_cast<std::uint8_t>(s.fsm_state);
+  r.flags = static_cast<std::uint8_t>((s.event_started ? kRecordEventStarted : 0) |
+                                      (s.event_ended ? kRecordEventEnded : 0));
+  r.backend = static_cast<std::uint8_t>((s.tcn_available ? kRecordTcnAvailable : 0) |
+                                        (s.tcn_used_for_latest ? kRecordTcnUsed : 0));
+  return r;
+}
+
+void DecodeRecord(const TelemetryRecord& r, TelemetrySnapshot* out) {
+  if (!out) return;
+  *out = TelemetrySnapshot{};
+  out->t_ns = r.t_ns;
+  out->p_detect_latest = r.p_detect;
+  out->fsm_state = static_cast<FsmState>(std::min<int>(r.fsm_state, static_cast<int>(FsmState::COOLDOWN)));
+  out->event_started = (r.flags & kRecordEventStarted) != 0;
+  out->event_ended = (r.flags & kRecordEventEnded) != 0;
+  out->tcn_available = (r.backend & kRecordTcnAvailable) != 0;
+  out->tcn_used_for_latest = (r.backend & kRecordTcnUsed) != 0;
+}
+
+// --- TelemetryRecorder ---
+
+TelemetryRecorder::~TelemetryRecorder() { Close(); }
+
+std::string TelemetryRecorder::FileName(const std::string& prefix, std::uint64_t file_index) {
+  char suffix[32];
+  std::snprintf(suffix, sizeof(suffix), "_%06llu.trec", static_cast<unsigned long long>(file_index));
+  return prefix + suffix;
+}
+
+std::string TelemetryRecorder::current_path() const {
+  return is_open() ? FileName(cfg_.path_prefix, file_index_) : std::string();
+}
+
+bool TelemetryRecorder::Open(const Config& cfg) {
+  Close();
+  if (cfg.path_prefix.empty() || cfg.records_per_file == 0) {
+    std::cerr << "[TelemetryRecorder] empty path prefix or zero records per file\n";
+    return false;
+  }
+  cfg_ = cfg;
+  stats_ = Stats{};
+
+  const std::filesystem::path dir = std::filesystem::path(cfg_.path_prefix).parent_path();
+  if (!dir.empty()) {
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+  }
+  return OpenFile(0);
+}
+
+void TelemetryRecorder::Close() {
+  file_.Close();
+  header_ = nullptr;
+  records_ = nullptr;
+}
+
+bool TelemetryRecorder::OpenFile(std::uint64_t file_index) {
+  Close();
+  const std::string path = FileName(cfg_.path_prefix, file_index);
+  const std::size_t bytes = sizeof(RecordFileHeader) + cfg_.records_per_file * sizeof(TelemetryRecord);
+  if (!file_.Create(path, bytes)) return false;
+
+  header_ = reinterpret_cast<RecordFileHeader*>(file_.data());
+  records_ = reinterpret_cast<TelemetryRecord*>(file_.data() + sizeof(RecordFileHeader));
+  std::memset(header_, 0, sizeof(RecordFileHeader));
+  std::memcpy(header_->magic, kRecordFileMagic, sizeof(header_->magic));
+  header_->version = kRecordFileVersion;
+  header_->record_size = sizeof(TelemetryRecord);
+  header_->capacity = cfg_.records_per_file;
+  header_->file_index = file_index;
+  header_->created_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::system_clock::now().time_since_epoch()).count();
+
+  file_index_ = file_index;
+  ++stats_.files;
+
+  // Rotation: keep the newest max_files files
+  if (cfg_.max_files > 0 && file_index >= static_cast<std::uint64_t>(cfg_.max_files)) {
+    std::error_code ec;
+    std::filesystem::remove(FileName(cfg_.path_prefix, file_index - static_cast<std::uint64_t>(cfg_.max_files)), ec);
+  }
+  return true;
+}
+
+void TelemetryRecorder::Record(const TelemetrySnapshot& s) {
+  if (!header_) {
+    ++stats_.write_failures;
+    return;
+  }
+  std::uint64_t n = header_->count;
+  if (n == header_->capacity) {
+    if (!OpenFile(file_index_ + 1)) {
+      std::cerr << "[TelemetryRecorder] rotation failed, recording stopped\n";
+      ++stats_.write_failures;
+      return;
+    }
+    n = 0;
+  }
+  records_[n] = EncodeRecord(s);
+  // Release store: the record lands before the count that exposes it, so neither a crash
+  // nor a concurrent reader of the mapping sees a partial one
+  std::atomic_ref<std::uint64_t>(header_->count).store(n + 1, std::memory_order_release);
+  ++stats_.records;
+}
+
+// --- TelemetryRecordReader ---
+
+bool TelemetryRecordReader::Open(const std::string& path) {
+  Close();
+  if (!file_.OpenRead(path)) return false;
+
+  if (file_.size() < sizeof(RecordFileHeader)) {
+    std::cerr << "[TelemetryRecordReader] " << path << ": too small for a recorder file\n";
+    Close();
+    return false;
+  }
+  const auto* h = reinterpret_cast<const RecordFileHeader*>(file_.data());
+  if (std::memcmp(h->magic, kRecordFileMagic, sizeof(h->magic)) != 0 ||
+      h->version != kRecordFileVersion || h->record_size != sizeof(TelemetryRecord)) {
+    std::cerr << "[TelemetryRecordReader] " << path << ": not a telemetry record file (or unsupported version)\n";
+    Close();
+    return false;
+  }
+
+  // Trust the header only as far as the file actually goes
+  const std::uint64_t slots = (file_.size() - sizeof(RecordFileHeader)) / sizeof(TelemetryRecord);
+  header_ = h;
+  records_ = reinterpret_cast<const TelemetryRecord*>(file_.data() + sizeof(RecordFileHeader));
+  count_ = std::min({h->count, h->capacity, slots});
+  return true;
+}
+
+}  // namespace core::telemetry
@@ -0,0 +1,132 @@
+#include "core/telemetry/telemetry_snapshot_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <new>
+
+namespace core::telemetry {
+
+namespace detail {
+
+// Slot storage + in-use flags. Reference counted by hand (the pool + every live
+// snapshot, pooled or heap fallback) so allocator copies stay plain pointers.
+class SnapshotSlab {
+ public:
+  // Object plus the shared_ptr control block around it
+  static constexpr std::size_t kSlotAlign = 64;
+  static constexpr std::size_t kSlotBytes =
+      (sizeof(TelemetrySnapshot) + 128 + kSlotAlign - 1) / kSlotAlign * kSlotAlign;
+
+  explicit SnapshotSlab(int capacity)
+      : capacity_(std::max(1, capacity)),
+        slots_(std::make_unique<Slot[]>(static_cast<std::size_t>(capacity_))),
+        in_use_flags_(std::make_unique<std::atomic<bool>[]>(static_cast<std::size_t>(capacity_))) {
+    for (int i = 0; i < capacity_; ++i) in_use_flags_[static_cast<std::size_t>(i)].store(false, std::memory_order_relaxed);
+  }
+
+  void Ref() { refs_.fetch_add(1, std::memory_order_relaxed); }
+  void Unref() {
+    if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+  }
+
+  // Free slot or nullptr (pool full)
+  void* Take() {
+    const int start = hint_.load(std::memory_order_relaxed);
+    for (int k = 0; k < capacity_; ++k) {
+      const int i = (start + k) % capacity_;
+      std::atomic<bool>& flag = in_use_flags_[static_cast<std::size_t>(i)];
+      if (flag.load(std::memory_order_relaxed)) continue;
+      if (flag.exchange(true, std::memory_order_acquire)) continue;
+      hint_.store((i + 1) % capacity_, std::memory_order_relaxed);
+      in_use_.fetch_add(1, std::memory_order_relaxed);
+      return slots_[static_cast<std::size_t>(i)].bytes;
+    }
+    return nullptr;
+  }
+
+  // false if p is not a slot of this slab
+  bool Give(void* p) {
+    auto* slot = static_cast<Slot*>(p);
+    const std::less<const Slot*> before;  // total order, p may come from anywhere
+    if (before(slot, slots_.get()) || !before(slot, slots_.get() + capacity_)) return false;
+    in_use_flags_[static_cast<std::size_t>(slot - slots_.get())].store(false, std::memory_order_release);
+    in_use_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  int capacity() const { return capacity_; }
+  int in_use() const { return in_use_.load(std::memory_order_relaxed); }
+
+  std::atomic<std::uint64_t> acquired{0};
+  std::atomic<std::uint64_t> heap_fallbacks{0};
+
+ private:
+  struct alignas(kSlotAlign) Slot {
+    std::byte bytes[kSlotBytes];
+  };
+
+  int capacity_;
+  std::unique_ptr<Slot[]> slots_;
+  std::unique_ptr<std::atomic<bool>[]> in_use_flags_;
+  std::atomic<int> hint_{0};
+  std::atomic<int> in_use_{0};
+  std::atomic<int> refs_{1};  // the pool's reference
+};
+
+// allocate_shared allocator: one slot per control block, heap if the pool is full.
+// Each allocation holds one slab reference until it is deallocated.
+template <class T>
+struct SlabAllocator {
+  using value_type = T;
+
+  explicit SlabAllocator(SnapshotSlab* s) : slab(s) {}
+  template <class U>
+  SlabAllocator(const SlabAllocator<U>& other) : slab(other.slab) {}
+
+  T* allocate(std::size_t n) {
+    slab->Ref();
+    if (n == 1 && sizeof(T) <= SnapshotSlab::kSlotBytes && alignof(T) <= SnapshotSlab::kSlotAlign) {
+      if (void* p = slab->Take()) return static_cast<T*>(p);
+    }
+    slab->heap_fallbacks.fetch_add(1, std::memory_order_relaxed);
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T* p, std::size_t /*n*/) {
+    SnapshotSlab* s = slab;  // this allocator may live inside the block being freed
+    if (!s->Give(p)) ::operator delete(p);
+    s->Unref();
+  }
+
+  template <class U>
+  bool operator==(const SlabAllocator<U>& other) const { return slab == other.slab; }
+
+  SnapshotSlab* slab;
+};
+
+}  // namespace detail
+
+TelemetrySnapshotPool::TelemetrySnapshotPool(int capacity)
+    : slab_(new detail::SnapshotSlab(capacity)) {}
+
+TelemetrySnapshotPool::~TelemetrySnapshotPool() {
+  slab_->Unref();  // freed here or by the last snapshot still alive
+}
+
+std::shared_ptr<TelemetrySnapshot> TelemetrySnapshotPool::Acquire() {
+  slab_->acquired.fetch_add(1, std::memory_order_relaxed);
+  return std::allocate_shared<TelemetrySnapshot>(detail::SlabAllocator<TelemetrySnapshot>(slab_));
+}
+
+TelemetrySnapshotPool::Stats TelemetrySnapshotPool::stats() const {
+  Stats s;
+  s.acquired = slab_->acquired.load(std::memory_order_relaxed);
+  s.heap_fallbacks = slab_->heap_fallbacks.load(std::memory_order_relaxed);
+  s.in_use = slab_->in_use();
+  s.capacity = slab_->capacity();
+  return s;
+}
+
+}  // namespace core::telemetry
@@ -1,39 +1,74 @@
 #pragma once
 
+#include <span>
 #include <string>
 #include <vector>
 
+#include "core/detect/i_window_model.h"
 #include "core/tflite/tflite_runner.h"
 
 namespace core::ml {
 
     // Minimal detector wrapper for your model input shape (1, 128, 169, 1).
-    // Feeds float32 input for dynamic-quant tflite.
-    class TcnDetector {
+    // Takes float32 PCEN windows for both model kinds, picked from the input tensor type:
+    // - dynamic-range (float32 input): fed as is;
+    // - fully quantized (int8/uint8 input/output): quantized on the way in with the
+    //   tensor's scale / zero point, scores dequantized on the way out.
+    // As an IWindowModel (AsyncWindowDetector): input_buffer() is the interpreter's input
+    // tensor for float models (the window is written straight into it), or a float staging
+    // window that Infer() quantizes into the tensor; p_detect = score of the argmax class.
+    // No allocation per call.
+    //
+    // Streaming exports (state tensors, see TfliteRunner::state_count()) take step_frames()
+    // new frames per Invoke() instead of the whole window; the runner carries the causal
+    // convolution caches between calls. Under AsyncWindowDetector only the new frames are
+    // fed, one step per Infer(). Run() rebuilds the state from zero over all n_frames frames
+    // of the window it is given (zero-padded to whole steps): same scores, no saving.
+    class TcnDetector : public core::detect::IWindowModel {
     public:
         struct Config {
             std::string model_path;      // e.g. "model_dynamic.tflite"
             std::string class_names_path; // e.g. "class_names.txt"
             int n_mels = 128;
-            int n_frames = 169;          // time frames
+            int n_frames = 169;          // time frames (receptive field of streaming models)
+            TfliteRunnerOptions runner;  // threads / XNNPACK
         };
 
         explicit TcnDetector(const Config& cfg);
 
-        bool IsValid() const { return runner_.IsValid() && !class_names_.empty(); }
+        bool IsValid() const {
+            return runner_.IsValid() && !class_names_.empty() && input_ok_;
+        }
+        bool streaming() const { return step_frames_ > 0; }
 
         // Input: PCEN window flattened as float32, length = n_mels*n_frames
-        // Output: fills probs/logits; returns argmax class index (or -1 on error)
+        // (not copied if it already is input_buffer())
+        // Output: fills probs/logits (reusing out_scores' capacity; may be null);
+        // returns argmax class index (or -1 on error)
         int Run(const float* pcen_window, int pcen_size, std::vector<float>* out_scores);
 
         const std::vector<std::string>& class_names() const { return class_names_; }
 
+        // IWindowModel
+        int n_mels() const override { return cfg_.n_mels; }
+        int n_frames() const override { return cfg_.n_frames; }
+        float* input_buffer() override;  // nullptr if the model input size does not match
+        bool Infer(float* p_detect) override;
+        int step_frames() const override { return step_frames_; }
+        void ResetState() override { runner_.ResetState(); }
+
     private:
         static std::vector<std::string> LoadLines(const std::string& path);
+        static int ArgMax(std::span<const float> scores);
+        int RunStreaming(const float* pcen_window, std::vector<float>* out_scores);
 
         Config cfg_;
         TfliteRunner runner_;
         std::vector<std::string> class_names_;
+        std::vector<float> staging_;  // input_buffer() of quantized models
+        std::vector<float> first_step_;  // zero-padded first step of RunStreaming()
+        int step_frames_ = 0;         // > 0: streaming model
+        bool input_ok_ = false;       // model input is n_mels*n_frames (step*n_mels when streaming)
     };
 
 }  // namespace core::ml
@@ -1,36 +1,131 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
+#include "core/dsp/quantize_kernel.h"
 #include "tensorflow/lite/interpreter.h"
 #include "tensorflow/lite/kernels/register.h"
 #include "tensorflow/lite/model.h"
 
 namespace core::ml {
 
+	// Interpreter setup for TfliteRunner
+	struct TfliteRunnerOptions {
+		// Interpreter (and XNNPACK) threads: -1 = TFLite default (unchanged behaviour),
+		// 0 = hardware threads (max 4; competes with the audio and inference threads),
+		// > 0 as given
+		int num_threads = -1;
+
+		// XNNPACK delegate, configured explicitly. When off the interpreter keeps the
+		// default delegates of the TFLite build (some builds apply XNNPACK by default;
+		// the startup log shows whether any node was delegated).
+		bool xnnpack = false;
+		bool xnnpack_fp16 = false;          // force fp16 inference (ARMv8.2 / AVX512-FP16)
+		bool xnnpack_dynamic_range = false; // dynamic-range quantized fully connected ops
+
+		bool log = true; // print the applied configuration
+	};
+
+	// What the runner actually got (options may be unsupported by the TFLite build)
+	struct TfliteRunnerApplied {
+		int num_threads = -1;
+		bool xnnpack = false;
+		bool xnnpack_fp16 = false;
+		bool xnnpack_dynamic_range = false;
+		int model_nodes = 0;     // operators in the model
+		int plan_nodes = 0;      // nodes in the execution plan after delegation
+		int delegate_nodes = 0;  // of those, delegate kernels (each replaces a partition)
+	};
+
 	class TfliteRunner {
 	public:
-		explicit TfliteRunner(const std::string& model_path);
+		explicit TfliteRunner(const std::string& model_path, const TfliteRunnerOptions& opt = {});
 
 		bool IsValid() const { return valid_; }
+		const TfliteRunnerApplied& applied() const { return applied_; }
+
+		// Zero-copy binding: write the input straight into input_span(), Invoke(), read
+		// output_span(). Spans stay valid for the runner's lifetime: tensors are allocated
+		// once. No allocation per call.
+		// input_span() is the float32 input tensor; empty for quantized inputs (and if the
+		// runner is invalid), those are written with SetInput().
+		// output_span() is always float: the output tensor, or for int8/uint8 outputs a
+		// buffer Invoke() dequantizes into.
+		std::span<float> input_span();
+		std::span<const float> output_span() const;
+		bool Invoke();
+
+		// Writes a float window into the input tensor: copied for float32 models (skipped if
+		// it already is input_span()), quantized with the tensor's scale / zero point for
+		// int8/uint8 models (SIMD, core::dsp::QuantizeInt8). false on size mismatch.
+		bool SetInput(std::span<const float> input);
 
-		// input: pointer to contiguous float buffer (dynamic-quant model expects float32)
-		// returns: output vector (logits or probabilities; depends on the model)
+		// SetInput(), Invoke(), copies the output into *out (reuses its capacity).
+		// false on size mismatch or Invoke() failure.
+		bool RunFloat(std::span<const float> input, std::vector<float>* out);
+
+		// input: pointer to contiguous float buffer (quantized if the model input is int8/uint8)
+		// returns: output vector (logits or probabilities; depends on the model). Allocates.
 		std::vector<float> RunFloat(const float* input, int input_size);
 
 		int input_size() const { return input_size_; }
 		int output_size() const { return output_size_; }
 
+		// kTfLiteFloat32, kTfLiteInt8 or kTfLiteUInt8
+		TfLiteType input_type() const { return input_type_; }
+		TfLiteType output_type() const { return output_type_; }
+		bool input_quantized() const { return input_type_ != kTfLiteFloat32; }
+		bool output_quantized() const { return output_type_ != kTfLiteFloat32; }
+		// Scale / zero point of quantized tensors (per-tensor)
+		const core::dsp::QuantParams& input_quant() const { return input_quant_; }
+		const core::dsp::QuantParams& output_quant() const { return output_quant_; }
+
+		// Streaming models: inputs [1..n) are recurrent state (e.g. causal conv caches) and
+		// outputs [1..n) their next values, same order, type, size and quantization. Input 0 /
+		// output 0 stay the frames / scores. Invoke() copies each state output back into its
+		// input; ResetState() zeroes them (zero point for quantized tensors). Models with one
+		// input have no state.
+		int state_count() const { return static_cast<int>(states_.size()); }
+		std::size_t state_bytes() const;
+		void ResetState();
+
 	private:
+		using DelegatePtr = std::unique_ptr<TfLiteDelegate, void (*)(TfLiteDelegate*)>;
+
+		bool ApplyXnnpack(const TfliteRunnerOptions& opt, int threads);
+		void DescribePlan();
+		// float32 / int8 / uint8 with a usable scale; fills *q for the quantized ones
+		static bool BindTensorType(const TfLiteTensor* t, const char* what, core::dsp::QuantParams* q);
+		bool BindStates();
+
 		bool valid_{ false };
+		TfliteRunnerApplied applied_;
 
 		std::unique_ptr<tflite::FlatBufferModel> model_;
+		DelegatePtr delegate_{ nullptr, nullptr }; // outlives interpreter_ (declared before it)
 		std::unique_ptr<tflite::Interpreter> interpreter_;
 
 		int input_size_{ 0 };
 		int output_size_{ 0 };
+
+		TfLiteType input_type_{ kTfLiteFloat32 };
+		TfLiteType output_type_{ kTfLiteFloat32 };
+		core::dsp::QuantParams input_quant_;
+		core::dsp::QuantParams output_quant_;
+		std::vector<float> output_dequant_;  // output_span() for quantized outputs
+
+		struct StateTensor {
+			int input = -1;   // tensor indices
+			int output = -1;
+			std::size_t bytes = 0;
+			std::uint8_t zero = 0;  // byte value of 0.0
+		};
+		std::vector<StateTensor> states_;
 	};
 
 }  // namespace core::ml
@@ -20,7 +20,7 @@ namespace core::ml {
 
     TcnDetector::TcnDetector(const Config& cfg)
         : cfg_(cfg),
-        runner_(cfg.model_path),
+        runner_(cfg.model_path, cfg.runner),
         class_names_(LoadLines(cfg.class_names_path)) {
         if (!runner_.IsValid()) {
             std::cerr << "[TcnDetector] runner invalid\n";
@@ -31,12 +31,46 @@ namespace core::ml {
             return;
         }
 
-        // Basic sanity check: expected input size 1*128*169*1 = 21632
-        const int expected = cfg_.n_mels * cfg_.n_frames;
-        if (runner_.input_size() != expected) {
-            std::cerr << "[TcnDetector] input_size mismatch. runner=" << runner_.input_size()
-                << " expected=" << expected << "\n";
+        if (runner_.state_count() > 0) {
+            // Streaming export: input = the newest step_frames frames
+            const int in = runner_.input_size();
+            if (in <= 0 || in % cfg_.n_mels != 0 || in / cfg_.n_mels > cfg_.n_frames) {
+                std::cerr << "[TcnDetector] streaming input_size " << in << " is not k*" << cfg_.n_mels
+                    << " with k <= " << cfg_.n_frames << "\n";
+                return;
+            }
+            step_frames_ = in / cfg_.n_mels;
+            if (cfg_.n_frames % step_frames_ != 0) {
+                first_step_.assign(static_cast<std::size_t>(in), 0.0f);  // Run(): zero-padded first step
+            }
+            std::cout << "[TcnDetector] streaming model: " << step_frames_ << " frame(s) per step, "
+                << runner_.state_count() << " state tensors (" << runner_.state_bytes() << " bytes)\n";
+        }
+        else {
+            // Basic sanity check: expected input size 1*128*169*1 = 21632
+            // Mismatch is fatal: input_buffer() users write n_mels*n_frames floats into it
+            const int expected = cfg_.n_mels * cfg_.n_frames;
+            if (runner_.input_size() != expected) {
+                std::cerr << "[TcnDetector] input_size mismatch. runner=" << runner_.input_size()
+                    << " expected=" << expected << "\n";
+                return;
+            }
         }
+        if (runner_.input_quantized()) {
+            staging_.assign(static_cast<std::size_t>(runner_.input_size()), 0.0f);
+        }
+        input_ok_ = true;
+    }
+
+    float* TcnDetector::input_buffer() {
+        if (!input_ok_) return nullptr;
+        if (!staging_.empty()) return staging_.data();
+        return runner_.input_span().data();
+    }
+
+    int TcnDetector::ArgMax(std::span<const float> scores) {
+        if (scores.empty()) return -1;
+        return static_cast<int>(std::max_element(scores.begin(), scores.end()) - scores.begin());
     }
 
     int TcnDetector::Run(const float* pcen_window, int pcen_size, std::vector<float>* out_scores) {
@@ -45,21 +79,50 @@ namespace core::ml {
         const int expected = cfg_.n_mels * cfg_.n_frames;
         if (pcen_size != expected) return -1;
 
-        auto scores = runner_.RunFloat(pcen_window, pcen_size);
-        if (scores.empty()) return -1;
+        if (step_frames_ > 0) return RunStreaming(pcen_window, out_scores);
 
-        if (out_scores) *out_scores = scores;
+        if (!runner_.RunFloat(std::span<const float>(pcen_window, static_cast<std::size_t>(pcen_size)), out_scores)) return -1;
+        return ArgMax(runner_.output_span());
+    }
 
-        // argmax
-        int best = 0;
-        float bestv = scores[0];
-        for (int i = 1; i < static_cast<int>(scores.size()); ++i) {
-            if (scores[i] > bestv) {
-                bestv = scores[i];
-                best = i;
+    int TcnDetector::RunStreaming(const float* pcen_window, std::vector<float>* out_scores) {
+        // All n_frames frames in whole steps: with n_frames % step != 0 the first step starts
+        // with zero frames (the zero-state contract), as if the window was zero-padded
+        const std::size_t n_mels = static_cast<std::size_t>(cfg_.n_mels);
+        const int steps = (cfg_.n_frames + step_frames_ - 1) / step_frames_;
+        const std::size_t pad = static_cast<std::size_t>(steps * step_frames_ - cfg_.n_frames) * n_mels;
+        const std::size_t step = static_cast<std::size_t>(step_frames_) * n_mels;
+        const float* p = pcen_window;
+
+        runner_.ResetState();
+        for (int k = 0; k < steps; ++k) {
+            std::span<const float> in(p, step);
+            if (k == 0 && pad > 0) {
+                std::copy(p, p + (step - pad), first_step_.begin() + static_cast<std::ptrdiff_t>(pad));
+                in = first_step_;
+                p += step - pad;
+            }
+            else {
+                p += step;
             }
+            if (!runner_.SetInput(in) || !runner_.Invoke()) return -1;
         }
-        return best;
+
+        const std::span<const float> scores = runner_.output_span();
+        if (out_scores) out_scores->assign(scores.begin(), scores.end());
+        return ArgMax(scores);
+    }
+
+    bool TcnDetector::Infer(float* p_detect) {
+        if (!IsValid()) return false;
+        if (!staging_.empty() && !runner_.SetInput(staging_)) return false;
+        if (!runner_.Invoke()) return false;
+
+        const std::span<const float> scores = runner_.output_span();
+        const int best = ArgMax(scores);
+        if (best < 0) return false;
+        if (p_detect) *p_detect = std::clamp(scores[static_cast<std::size_t>(best)], 0.0f, 1.0f);
+        return true;
     }
 
 }  // namespace core::ml
@@ -1,24 +1,65 @@
 #include "core/tflite/tflite_runner.h"
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
+#include <thread>
+
+#if __has_include("tensorflow/lite/delegates/xnnpack/xnnpack_delegate.h")
+#include "tensorflow/lite/delegates/xnnpack/xnnpack_delegate.h"
+#define UAV_TFLITE_HAS_XNNPACK 1
+#else
+#define UAV_TFLITE_HAS_XNNPACK 0
+#endif
 
 namespace core::ml {
 
-    TfliteRunner::TfliteRunner(const std::string& model_path) {
+    namespace {
+
+        const char* TypeName(TfLiteType t) {
+            switch (t) {
+            case kTfLiteFloat32: return "float32";
+            case kTfLiteInt8: return "int8";
+            case kTfLiteUInt8: return "uint8";
+            default: return "?";
+            }
+        }
+
+    }  // namespace
+
+    TfliteRunner::TfliteRunner(const std::string& model_path, const TfliteRunnerOptions& opt) {
         model_ = tflite::FlatBufferModel::BuildFromFile(model_path.c_str());
         if (!model_) {
             std::cerr << "[TfliteRunner] Failed to load model: " << model_path << "\n";
             return;
         }
 
-        tflite::ops::builtin::BuiltinOpResolver resolver;
-        tflite::InterpreterBuilder builder(*model_, resolver);
-        builder(&interpreter_);
+        int threads = opt.num_threads;
+        if (threads == 0) {
+            threads = std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, 4);
+        }
+
+        // Explicit XNNPACK: no default delegates, the one configured here is applied below
+        if (opt.xnnpack) {
+            tflite::ops::builtin::BuiltinOpResolverWithoutDefaultDelegates resolver;
+            tflite::InterpreterBuilder builder(*model_, resolver);
+            builder(&interpreter_, threads);
+        }
+        else {
+            tflite::ops::builtin::BuiltinOpResolver resolver;
+            tflite::InterpreterBuilder builder(*model_, resolver);
+            builder(&interpreter_, threads);
+        }
         if (!interpreter_) {
             std::cerr << "[TfliteRunner] Failed to create interpreter\n";
             return;
         }
+        applied_.num_threads = threads;
+        applied_.model_nodes = static_cast<int>(interpreter_->nodes_size());
+
+        if (opt.xnnpack && !ApplyXnnpack(opt, threads)) {
+            std::cerr << "[TfliteRunner] XNNPACK delegate not applied, running built-in kernels\n";
+        }
 
         if (interpreter_->AllocateTensors() != kTfLiteOk) {
             std::cerr << "[TfliteRunner] AllocateTensors() failed\n";
@@ -34,12 +75,9 @@ namespace core::ml {
         TfLiteTensor* in = interpreter_->tensor(in_idx);
         if (!in) return;
 
-        // Expect float32 for dynamic quant model
-        if (in->type != kTfLiteFloat32) {
-            std::cerr << "[TfliteRunner] Unexpected input type: " << in->type
-                << " (expected float32 for dynamic model)\n";
-            return;
-        }
+        // float32 (dynamic-range model) or int8/uint8 (fully quantized model)
+        if (!BindTensorType(in, "input", &input_quant_)) return;
+        input_type_ = in->type;
 
         int in_elems = 1;
         for (int i = 0; i < in->dims->size; ++i) in_elems *= in->dims->data[i];
@@ -54,34 +92,211 @@ namespace core::ml {
         TfLiteTensor* out = interpreter_->tensor(out_idx);
         if (!out) return;
 
+        if (!BindTensorType(out, "output", &output_quant_)) return;
+        output_type_ = out->type;
+
         int out_elems = 1;
         for (int i = 0; i < out->dims->size; ++i) out_elems *= out->dims->data[i];
         output_size_ = out_elems;
+        if (output_quantized()) output_dequant_.assign(static_cast<std::size_t>(out_elems), 0.0f);
 
+        if (!BindStates()) return;
+
+        DescribePlan();
+        if (opt.log) {
+            std::cout << "[TfliteRunner] threads=" << applied_.num_threads
+                << " xnnpack=" << (applied_.xnnpack ? "on" : "off")
+                << (applied_.xnnpack_fp16 ? " +fp16" : "")
+                << (applied_.xnnpack_dynamic_range ? " +dynamic_range" : "")
+                << " plan: " << applied_.plan_nodes << " nodes for " << applied_.model_nodes << " ops, "
+                << applied_.delegate_nodes << " delegated partition(s)"
+                << " io=" << TypeName(input_type_) << "/" << TypeName(output_type_);
+            if (!states_.empty()) std::cout << " state=" << states_.size() << " tensors, " << state_bytes() << " bytes";
+            std::cout << "\n";
+        }
         valid_ = true;
     }
 
-    std::vector<float> TfliteRunner::RunFloat(const float* input, int input_size) {
-        std::vector<float> out_vec;
-        if (!valid_ || !interpreter_) return out_vec;
-        if (!input || input_size != input_size_) return out_vec;
+    bool TfliteRunner::ApplyXnnpack(const TfliteRunnerOptions& opt, int threads) {
+#if UAV_TFLITE_HAS_XNNPACK
+        TfLiteXNNPackDelegateOptions xopt = TfLiteXNNPackDelegateOptionsDefault();
+        xopt.num_threads = std::max(1, threads);
+
+        bool fp16 = false;
+        bool dynamic_range = false;
+        if (opt.xnnpack_fp16) {
+#ifdef TFLITE_XNNPACK_DELEGATE_FLAG_FORCE_FP16
+            xopt.flags |= TFLITE_XNNPACK_DELEGATE_FLAG_FORCE_FP16;
+            fp16 = true;
+#else
+            std::cerr << "[TfliteRunner] XNNPACK fp16 not supported by this TFLite build\n";
+#endif
+        }
+        if (opt.xnnpack_dynamic_range) {
+#ifdef TFLITE_XNNPACK_DELEGATE_FLAG_DYNAMIC_FULLY_CONNECTED
+            xopt.flags |= TFLITE_XNNPACK_DELEGATE_FLAG_DYNAMIC_FULLY_CONNECTED;
+            dynamic_range = true;
+#else
+            std::cerr << "[TfliteRunner] XNNPACK dynamic range not supported by this TFLite build\n";
+#endif
+        }
 
-        const int in_idx = interpreter_->inputs()[0];
-        float* in_ptr = interpreter_->typed_tensor<float>(in_idx);
-        if (!in_ptr) return out_vec;
+        DelegatePtr delegate(TfLiteXNNPackDelegateCreate(&xopt), &TfLiteXNNPackDelegateDelete);
+        if (!delegate) return false;
+        if (interpreter_->ModifyGraphWithDelegate(delegate.get()) != kTfLiteOk) return false;
 
-        std::memcpy(in_ptr, input, sizeof(float) * static_cast<size_t>(input_size_));
+        delegate_ = std::move(delegate);
+        applied_.xnnpack = true;
+        applied_.xnnpack_fp16 = fp16;
+        applied_.xnnpack_dynamic_range = dynamic_range;
+        return true;
+#else
+        (void)opt;
+        (void)threads;
+        std::cerr << "[TfliteRunner] XNNPACK delegate header not available in this TFLite build\n";
+        return false;
+#endif
+    }
+
+    void TfliteRunner::DescribePlan() {
+        const std::vector<int>& plan = interpreter_->execution_plan();
+        applied_.plan_nodes = static_cast<int>(plan.size());
+        applied_.delegate_nodes = 0;
+        for (int idx : plan) {
+            const auto* nr = interpreter_->node_and_registration(idx);
+            if (nr && nr->first.delegate != nullptr) ++applied_.delegate_nodes;
+        }
+    }
 
+    bool TfliteRunner::BindTensorType(const TfLiteTensor* t, const char* what, core::dsp::QuantParams* q) {
+        if (t->type == kTfLiteFloat32) return true;
+        if (t->type != kTfLiteInt8 && t->type != kTfLiteUInt8) {
+            std::cerr << "[TfliteRunner] Unexpected " << what << " type: " << t->type
+                << " (expected float32, int8 or uint8)\n";
+            return false;
+        }
+        if (!(t->params.scale > 0.0f)) {
+            std::cerr << "[TfliteRunner] Quantized " << what << " without scale\n";
+            return false;
+        }
+        q->scale = t->params.scale;
+        q->zero_point = static_cast<int>(t->params.zero_point);
+        return true;
+    }
+
+    bool TfliteRunner::BindStates() {
+        const std::vector<int>& ins = interpreter_->inputs();
+        const std::vector<int>& outs = interpreter_->outputs();
+        states_.clear();
+        for (std::size_t i = 1; i < ins.size(); ++i) {
+            if (i >= outs.size()) {
+                std::cerr << "[TfliteRunner] State input " << i << " has no matching output\n";
+                return false;
+            }
+            const TfLiteTensor* in = interpreter_->tensor(ins[i]);
+            const TfLiteTensor* out = interpreter_->tensor(outs[i]);
+            if (!in || !out || !in->data.raw || !out->data.raw || in->type != out->type || in->bytes != out->bytes ||
+                in->params.scale != out->params.scale || in->params.zero_point != out->params.zero_point) {
+                std::cerr << "[TfliteRunner] State input " << i << " does not match output " << i
+                    << " (type, size or quantization)\n";
+                return false;
+            }
+
+            StateTensor st;
+            st.input = ins[i];
+            st.output = outs[i];
+            st.bytes = in->bytes;
+            if (in->type == kTfLiteInt8 || in->type == kTfLiteUInt8) {
+                st.zero = static_cast<std::uint8_t>(in->params.zero_point);
+            }
+            states_.push_back(st);
+        }
+        ResetState();  // the arena is not zeroed
+        return true;
+    }
+
+    std::size_t TfliteRunner::state_bytes() const {
+        std::size_t n = 0;
+        for (const StateTensor& st : states_) n += st.bytes;
+        return n;
+    }
+
+    void TfliteRunner::ResetState() {
+        for (const StateTensor& st : states_) {
+            std::memset(interpreter_->tensor(st.input)->data.raw, st.zero, st.bytes);
+        }
+    }
+
+    std::span<float> TfliteRunner::input_span() {
+        if (!valid_ || !interpreter_ || input_quantized()) return {};
+        float* p = interpreter_->typed_tensor<float>(interpreter_->inputs()[0]);
+        if (!p) return {};
+        return { p, static_cast<std::size_t>(input_size_) };
+    }
+
+    std::span<const float> TfliteRunner::output_span() const {
+        if (!valid_ || !interpreter_) return {};
+        if (output_quantized()) return output_dequant_;
+        const float* p = interpreter_->typed_tensor<float>(interpreter_->outputs()[0]);
+        if (!p) return {};
+        return { p, static_cast<std::size_t>(output_size_) };
+    }
+
+    bool TfliteRunner::Invoke() {
+        if (!valid_ || !interpreter_) return false;
         if (interpreter_->Invoke() != kTfLiteOk) {
             std::cerr << "[TfliteRunner] Invoke() failed\n";
-            return out_vec;
+            return false;
         }
 
-        const int out_idx = interpreter_->outputs()[0];
-        const float* out_ptr = interpreter_->typed_tensor<float>(out_idx);
-        if (!out_ptr) return out_vec;
+        // Graph inputs and outputs never share arena memory, a plain copy is enough
+        for (const StateTensor& st : states_) {
+            std::memcpy(interpreter_->tensor(st.input)->data.raw, interpreter_->tensor(st.output)->data.raw, st.bytes);
+        }
+
+        if (output_quantized()) {
+            const TfLiteTensor* out = interpreter_->tensor(interpreter_->outputs()[0]);
+            const std::size_t n = output_dequant_.size();
+            if (output_type_ == kTfLiteInt8) {
+                core::dsp::DequantizeInt8(out->data.int8, n, output_quant_, output_dequant_.data());
+            }
+            else {
+                core::dsp::DequantizeUint8(out->data.uint8, n, output_quant_, output_dequant_.data());
+            }
+        }
+        return true;
+    }
 
-        out_vec.assign(out_ptr, out_ptr + output_size_);
+    bool TfliteRunner::SetInput(std::span<const float> input) {
+        if (!valid_ || !interpreter_ || input.size() != static_cast<std::size_t>(input_size_)) return false;
+
+        TfLiteTensor* in = interpreter_->tensor(interpreter_->inputs()[0]);
+        switch (input_type_) {
+        case kTfLiteInt8:
+            core::dsp::QuantizeInt8(input.data(), input.size(), input_quant_, in->data.int8);
+            return true;
+        case kTfLiteUInt8:
+            core::dsp::QuantizeUint8(input.data(), input.size(), input_quant_, in->data.uint8);
+            return true;
+        default:
+            if (input.data() != in->data.f) std::memcpy(in->data.f, input.data(), input.size_bytes());
+            return true;
+        }
+    }
+
+    bool TfliteRunner::RunFloat(std::span<const float> input, std::vector<float>* out) {
+        if (!SetInput(input) || !Invoke()) return false;
+
+        const std::span<const float> res = output_span();
+        if (res.empty()) return false;
+        if (out) out->assign(res.begin(), res.end());
+        return true;
+    }
+
+    std::vector<float> TfliteRunner::RunFloat(const float* input, int input_size) {
+        std::vector<float> out_vec;
+        if (!input || input_size <= 0) return out_vec;
+        if (!RunFloat(std::span<const float>(input, static_cast<std::size_t>(input_size)), &out_vec)) out_vec.clear();
         return out_vec;
     }
 
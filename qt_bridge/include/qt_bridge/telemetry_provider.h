@@ -4,7 +4,9 @@
 #include <QVariantList>
 #include <QTimer>
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "core/telemetry/telemetry_bus.h"
 #include "core/dsp/pcen_ring_buffer.h"
@@ -56,6 +58,7 @@ namespace qt_bridge {
         std::shared_ptr<core::telemetry::TelemetryBus> bus_;
         std::shared_ptr<core::dsp::PcenRingBuffer> pcen_rb_;
         PcenImageProvider* pcen_provider_ = nullptr;
+        std::vector<float> pcen_scratch_;  // reused PCEN copy for the image provider
 
         QTimer timer_;
 
@@ -63,7 +66,11 @@ namespace qt_bridge {
         QString fsm_state_str_ = "IDLE";
         int frame_id_ = 0;
 
+        // Plot history: last kTimelineWindow points, refreshed from the bus timeline by cursor
+        static constexpr int kTimelineWindow = 64;
         QVariantList timeline_;
+        std::uint64_t timeline_cursor_ = 0;
+        std::vector<core::telemetry::TimelinePoint> timeline_scratch_;
         QString detector_backend_ = "MOCK";
 
         bool event_started_ = false;
@@ -49,17 +49,22 @@ namespace qt_bridge {
             event_started_ = snap->event_started;
             event_ended_ = snap->event_ended;
 
-            // Build timeline list for QML Canvas
-            QVariantList list;
-            const int n = std::clamp(snap->timeline_n, 0, static_cast<int>(core::telemetry::TelemetrySnapshot::kMaxTimeline));
-            list.reserve(n);
-            for (int i = 0; i < n; ++i) {
+            // Timeline for QML Canvas: append only the points published since the last tick
+            // (cursor into the bus history), keep the last kTimelineWindow.
+            if (timeline_cursor_ == 0) {
+                const std::uint64_t head = bus_->TimelineHead();
+                timeline_cursor_ = head - std::min<std::uint64_t>(head, kTimelineWindow);
+            }
+            timeline_scratch_.resize(kTimelineWindow);
+            const auto read = bus_->ReadTimelineSince(timeline_cursor_, timeline_scratch_.data(), kTimelineWindow);
+            timeline_cursor_ = read.next_cursor;
+            for (int i = 0; i < read.points; ++i) {
                 QVariantMap m;
-                m["t"] = static_cast<qlonglong>(snap->timeline[static_cast<std::size_t>(i)].t_ns);
-                m["p"] = snap->timeline[static_cast<std::size_t>(i)].p_detect;
-                list.push_back(m);
+                m["t"] = static_cast<qlonglong>(timeline_scratch_[static_cast<std::size_t>(i)].t_ns);
+                m["p"] = timeline_scratch_[static_cast<std::size_t>(i)].p_detect;
+                timeline_.push_back(m);
             }
-            timeline_ = std::move(list);
+            while (timeline_.size() > kTimelineWindow) timeline_.removeFirst();
         }
         else {
             // no snapshot yet
@@ -72,9 +77,11 @@ namespace qt_bridge {
             int got_frames = 0;
             // Prefer stable UI: request fixed width (128 frames visible).
             const int want_frames = 128;
-            auto frames = pcen_rb_->SnapshotLast(want_frames, &got_frames);  // packed [got_frames][n_mels]
+            pcen_scratch_.resize(static_cast<std::size_t>(want_frames) * static_cast<std::size_t>(pcen_rb_->n_mels()));
+            got_frames = pcen_rb_->CopyLast(want_frames, pcen_scratch_.data(), want_frames);  // packed [got_frames][n_mels]
             if (got_frames > 0) {
-                pcen_provider_->SetPcenMatrix(std::move(frames), pcen_rb_->n_mels(), got_frames);
+                pcen_scratch_.resize(static_cast<std::size_t>(got_frames) * static_cast<std::size_t>(pcen_rb_->n_mels()));
+                pcen_provider_->SetPcenMatrix(pcen_scratch_, pcen_rb_->n_mels(), got_frames);
                 frame_id_++;
             }
         }